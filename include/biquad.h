@@ -0,0 +1,152 @@
+#ifndef QUICKWAVE_BIQUAD
+#define QUICKWAVE_BIQUAD
+
+#include <stddef.h>
+#include "filter.h"
+
+/**
+ * @brief 
+ * Coefficients of a second-order IIR section, normalized so that a0 = 1.
+ * The transfer function is (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2).
+ * First-order sections have b2 = a2 = 0.
+ */
+typedef struct {
+    double b0; /** Feedforward coefficient of the current input */
+    double b1; /** Feedforward coefficient of the previous input */
+    double b2; /** Feedforward coefficient of the input two samples ago */
+    double a1; /** Feedback coefficient of the previous output */
+    double a2; /** Feedback coefficient of the output two samples ago */
+} BiquadCoefficients;
+
+/**
+ * @brief 
+ * Second-order IIR section, evaluated in transposed direct form II
+ */
+typedef struct {
+    BiquadCoefficients coefficients; /** Section coefficients */
+    double state[2]; /** Transposed direct form II delay elements */
+} BiquadSection;
+
+/**
+ * @brief 
+ * Real-valued IIR filter made of cascaded second-order sections (biquads).
+ * This is much better conditioned than a single high-order feedback polynomial,
+ * and costs five multiplies per section per sample.
+ */
+typedef struct {
+    size_t n_sections; /** Number of sections in the cascade */
+    BiquadSection sections[]; /** Sections, in evaluation order */
+} BiquadCascadeReal;
+
+/**
+ * @brief 
+ * Makes and allocates a cascade of second-order sections
+ * @param n_sections Number of sections
+ * @param coefficients Coefficients of each section, in evaluation order
+ * @return Constructed filter
+ */
+BiquadCascadeReal *biquad_cascade_real_make(
+    size_t n_sections,
+    const BiquadCoefficients coefficients[]
+);
+
+/**
+ * @brief 
+ * Evaluates a cascade of second-order sections
+ * @param input Next input signal value
+ * @param filter Filter to apply
+ * @return Filtered value
+ */
+double biquad_cascade_real_evaluate(double input, BiquadCascadeReal *filter);
+
+/**
+ * @brief 
+ * Evaluates a cascade of second-order sections over a block of input values.
+ * Produces the same output as calling `biquad_cascade_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void biquad_cascade_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    BiquadCascadeReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a cascade of second-order sections to its initial state
+ * @param filter Filter to be reset
+ */
+void biquad_cascade_real_reset(BiquadCascadeReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a cascade of second-order sections
+ * @param filter Filter to be freed
+ */
+void biquad_cascade_real_free(BiquadCascadeReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a Butterworth low-pass or high-pass filter
+ * @param order Filter order
+ * @param cutoff_frequency Normalized -3 dB cutoff frequency
+ * @param filter_type The type of the filter. Can be low-pass or high-pass
+ * @return Constructed filter
+ */
+BiquadCascadeReal *biquad_make_butterworth(
+    size_t order,
+    double cutoff_frequency,
+    enum FilterType filter_type
+);
+
+/**
+ * @brief 
+ * Makes and allocates a Butterworth band-pass filter
+ * @param order Order of the low-pass prototype. The band-pass filter has twice this order.
+ * @param low_cutoff_frequency Normalized lower -3 dB frequency
+ * @param high_cutoff_frequency Normalized upper -3 dB frequency
+ * @return Constructed filter
+ */
+BiquadCascadeReal *biquad_make_butterworth_band_pass(
+    size_t order,
+    double low_cutoff_frequency,
+    double high_cutoff_frequency
+);
+
+/**
+ * @brief 
+ * Makes and allocates a Chebyshev type I low-pass or high-pass filter
+ * @param order Filter order
+ * @param ripple_db Peak-to-peak pass-band ripple, in decibels
+ * @param cutoff_frequency Normalized pass-band edge frequency, where the gain leaves the ripple band
+ * @param filter_type The type of the filter. Can be low-pass or high-pass
+ * @return Constructed filter
+ */
+BiquadCascadeReal *biquad_make_chebyshev(
+    size_t order,
+    double ripple_db,
+    double cutoff_frequency,
+    enum FilterType filter_type
+);
+
+/**
+ * @brief 
+ * Makes and allocates a Chebyshev type I band-pass filter
+ * @param order Order of the low-pass prototype. The band-pass filter has twice this order.
+ * @param ripple_db Peak-to-peak pass-band ripple, in decibels
+ * @param low_cutoff_frequency Normalized lower pass-band edge frequency
+ * @param high_cutoff_frequency Normalized upper pass-band edge frequency
+ * @return Constructed filter
+ */
+BiquadCascadeReal *biquad_make_chebyshev_band_pass(
+    size_t order,
+    double ripple_db,
+    double low_cutoff_frequency,
+    double high_cutoff_frequency
+);
+
+#endif
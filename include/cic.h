@@ -0,0 +1,168 @@
+#ifndef QUICKWAVE_CIC
+#define QUICKWAVE_CIC
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "filter.h"
+#include "window.h"
+
+/**
+ * @brief 
+ * Cascaded integrator-comb (CIC) decimator.
+ * Equivalent to `order` cascaded moving sums of `decimation * differential_delay` inputs,
+ * followed by downsampling, but needs no multiplies.
+ * Integrators run at the input rate and combs at the output rate.
+ * Accumulation is in 64-bit wraparound integer arithmetic,
+ * so integrator overflow cancels in the combs and the output is exact.
+ */
+typedef struct {
+    size_t order; /** Number of integrator and comb stages */
+    size_t rate_change; /** Decimation factor R */
+    size_t differential_delay; /** Comb delay M, in output samples */
+    size_t phase; /** Number of inputs received since the last output */
+    size_t comb_index; /** Position in each stage's ring of comb delays */
+    double output_scale; /** Factor applied to the integer output. 1 / (R M)^N with gain compensation, 1 otherwise. */
+    uint64_t state[]; /** `order` integrators, then `differential_delay` previous inputs of each comb */
+} CicDecimatorReal;
+
+/**
+ * @brief 
+ * Cascaded integrator-comb (CIC) interpolator.
+ * Combs run at the input rate, and the zero-stuffed comb output drives integrators at the output rate,
+ * so no multiplies are needed.
+ * Accumulation is in 64-bit wraparound integer arithmetic, so the output is exact.
+ */
+typedef struct {
+    size_t order; /** Number of integrator and comb stages */
+    size_t rate_change; /** Interpolation factor R */
+    size_t differential_delay; /** Comb delay M, in input samples */
+    size_t comb_index; /** Position in each stage's ring of comb delays */
+    double output_scale; /** Factor applied to the integer output. R / (R M)^N with gain compensation, 1 otherwise. */
+    uint64_t state[]; /** `order` integrators, then `differential_delay` previous inputs of each comb */
+} CicInterpolatorReal;
+
+/**
+ * @brief 
+ * Makes and allocates a CIC decimator
+ * @param order Number of integrator and comb stages
+ * @param decimation Downsampling factor R
+ * @param differential_delay Comb delay M, usually 1 or 2
+ * @param input_bits Number of significant bits of the signed inputs, at most 32.
+ * The output grows by `order * log2(R M)` bits, and must fit in 64 bits.
+ * @param is_gain_compensated Whether the output is divided by the DC gain (R M)^N
+ * @return Constructed filter
+ */
+CicDecimatorReal *cic_decimator_real_make(
+    size_t order,
+    size_t decimation,
+    size_t differential_delay,
+    size_t input_bits,
+    bool is_gain_compensated
+);
+
+/**
+ * @brief 
+ * Evaluates a CIC decimator over a block of input values.
+ * The downsampling phase is carried across calls, so blocks may have any length.
+ * @param input Integer input signal values, oldest first, such as ADC samples
+ * @param output Filtered and downsampled values. Must have room for `(length + decimation - 1) / decimation` values.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ * @return Number of output values
+ */
+size_t cic_decimator_real_process_block(
+    const int32_t *input,
+    double *output,
+    size_t length,
+    CicDecimatorReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a CIC decimator to its initial state
+ * @param filter Filter to be reset
+ */
+void cic_decimator_real_reset(CicDecimatorReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a CIC decimator
+ * @param filter Filter to be freed
+ */
+void cic_decimator_real_free(CicDecimatorReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a CIC interpolator
+ * @param order Number of integrator and comb stages
+ * @param interpolation Upsampling factor R
+ * @param differential_delay Comb delay M, usually 1 or 2
+ * @param input_bits Number of significant bits of the signed inputs, at most 32.
+ * The output grows by `order * log2(R M) - log2(R)` bits, and must fit in 64 bits.
+ * @param is_gain_compensated Whether the output is divided by the DC gain (R M)^N / R
+ * @return Constructed filter
+ */
+CicInterpolatorReal *cic_interpolator_real_make(
+    size_t order,
+    size_t interpolation,
+    size_t differential_delay,
+    size_t input_bits,
+    bool is_gain_compensated
+);
+
+/**
+ * @brief 
+ * Evaluates a CIC interpolator over a block of input values
+ * @param input Integer input signal values, oldest first
+ * @param output Interpolated values. Must have room for `length * interpolation` values.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ * @return Number of output values
+ */
+size_t cic_interpolator_real_process_block(
+    const int32_t *input,
+    double *output,
+    size_t length,
+    CicInterpolatorReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a CIC interpolator to its initial state
+ * @param filter Filter to be reset
+ */
+void cic_interpolator_real_reset(CicInterpolatorReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a CIC interpolator
+ * @param filter Filter to be freed
+ */
+void cic_interpolator_real_free(CicInterpolatorReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a windowed FIR filter that flattens the pass-band droop of a CIC filter.
+ * It runs at the low rate: after a CIC decimator, or before a CIC interpolator.
+ * The desired response is the inverse of the CIC response up to the cutoff and zero above it,
+ * and is windowed as for `filter_make_sinc`. The DC gain is 1.
+ * @param order Number of stages of the CIC filter
+ * @param rate_change Rate change factor R of the CIC filter
+ * @param differential_delay Comb delay M of the CIC filter
+ * @param cutoff_frequency Normalized cutoff frequency, at the low rate
+ * @param length Number of filter coefficients. Must be odd.
+ * @param window Windowing function. Only its first half is used, 
+ * so it should be symmetric, such as `window_hamming_symmetric`.
+ * @return Constructed filter
+ */
+DigitalFilterReal *cic_make_compensator(
+    size_t order,
+    size_t rate_change,
+    size_t differential_delay,
+    double cutoff_frequency,
+    size_t length,
+    WindowFunction window
+);
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef QUICKWAVE_EWMA
+#define QUICKWAVE_EWMA
+
+#include <stddef.h>
+#include <complex.h>
+
+/**
+ * @brief 
+ * Real-valued exponentially weighted moving average (EWMA), y = alpha x + (1 - alpha) y.
+ * Equivalent to `filter_make_ewma`, but stored and passed by value with no allocations.
+ */
+typedef struct {
+    double alpha; /** Smoothing factor. Smaller alpha means more smoothing. */
+    double previous_output; /** Most recent output */
+} EwmaReal;
+
+/**
+ * @brief 
+ * Complex-valued exponentially weighted moving average (EWMA), y = alpha x + (1 - alpha) y.
+ * Equivalent to `filter_make_ewma`, but stored and passed by value with no allocations.
+ */
+typedef struct {
+    double alpha; /** Smoothing factor. Smaller alpha means more smoothing. */
+    double complex previous_output; /** Most recent output */
+} EwmaComplex;
+
+/**
+ * @brief 
+ * Smoothing factor of the EWMA that acts as a first order IIR low-pass filter
+ * @param cutoff_frequency Normalized cutoff frequency, less than 0.5
+ * @return Smoothing factor
+ */
+double ewma_alpha_from_cutoff(double cutoff_frequency);
+
+/**
+ * @brief 
+ * Makes a real-valued EWMA
+ * @param alpha Smoothing factor 0 < alpha < 1. Smaller alpha means more smoothing.
+ * @return Constructed EWMA
+ */
+EwmaReal ewma_real_make(double alpha);
+
+/**
+ * @brief 
+ * Makes a real-valued first order IIR low-pass filter. Counterpart of `filter_make_first_order_iir`.
+ * @param cutoff_frequency Normalized cutoff frequency
+ * @return Constructed EWMA
+ */
+EwmaReal ewma_real_make_first_order_iir(double cutoff_frequency);
+
+/**
+ * @brief 
+ * Evaluates a real-valued EWMA
+ * @param input Next input signal value
+ * @param ewma EWMA to update
+ * @return Filtered value
+ */
+static inline double ewma_real_evaluate(double input, EwmaReal *ewma) {
+    ewma->previous_output += ewma->alpha * (input - ewma->previous_output);
+    return ewma->previous_output;
+}
+
+/**
+ * @brief 
+ * Evaluates a real-valued EWMA over a block of input values.
+ * Produces the same output as calling `ewma_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param ewma EWMA to update
+ */
+void ewma_real_process_block(const double *input, double *output, size_t length, EwmaReal *ewma);
+
+/**
+ * @brief 
+ * Resets a real-valued EWMA to its initial state
+ * @param ewma EWMA to reset
+ */
+void ewma_real_reset(EwmaReal *ewma);
+
+/**
+ * @brief 
+ * Makes a complex-valued EWMA
+ * @param alpha Smoothing factor 0 < alpha < 1. Smaller alpha means more smoothing.
+ * @return Constructed EWMA
+ */
+EwmaComplex ewma_complex_make(double alpha);
+
+/**
+ * @brief 
+ * Makes a complex-valued first order IIR low-pass filter. Counterpart of `filter_make_first_order_iir`.
+ * @param cutoff_frequency Normalized cutoff frequency
+ * @return Constructed EWMA
+ */
+EwmaComplex ewma_complex_make_first_order_iir(double cutoff_frequency);
+
+/**
+ * @brief 
+ * Evaluates a complex-valued EWMA
+ * @param input Next input signal value
+ * @param ewma EWMA to update
+ * @return Filtered value
+ */
+static inline double complex ewma_complex_evaluate(double complex input, EwmaComplex *ewma) {
+    ewma->previous_output += ewma->alpha * (input - ewma->previous_output);
+    return ewma->previous_output;
+}
+
+/**
+ * @brief 
+ * Evaluates a complex-valued EWMA over a block of input values.
+ * Produces the same output as calling `ewma_complex_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param ewma EWMA to update
+ */
+void ewma_complex_process_block(
+    const double complex *input,
+    double complex *output,
+    size_t length,
+    EwmaComplex *ewma
+);
+
+/**
+ * @brief 
+ * Resets a complex-valued EWMA to its initial state
+ * @param ewma EWMA to reset
+ */
+void ewma_complex_reset(EwmaComplex *ewma);
+
+#endif
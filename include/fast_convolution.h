@@ -0,0 +1,136 @@
+#ifndef QUICKWAVE_FAST_CONVOLUTION
+#define QUICKWAVE_FAST_CONVOLUTION
+
+#include <complex.h>
+#include "vector.h"
+#include "fft.h"
+
+/**
+ * @brief 
+ * FFT-based real-valued FIR filter, evaluated with the overlap-save method.
+ * Produces the same output as a `DigitalFilterReal` with the same feedforward coefficients,
+ * but at O(log N) rather than O(N) cost per sample for an N-tap filter.
+ */
+typedef struct {
+    FftComplex *fft; /** Transform of length `n_taps - 1 + block_length` */
+    double complex *kernel_spectrum; /** Spectrum of the zero-padded impulse response, prescaled by the inverse transform length */
+    double complex *work_area; /** Spectrum of the current input frame. Holds the filtered frame after the inverse transform. */
+    double *input_frame; /** The `n_taps - 1` inputs preceding the current block, followed by the inputs of the current block */
+    size_t n_taps; /** Number of filter coefficients */
+    size_t block_length; /** Number of outputs produced per transform */
+    size_t n_pending; /** Number of inputs of the current block received so far */
+} FastConvolutionReal;
+
+/**
+ * @brief 
+ * Makes and allocates an FFT-based FIR filter.
+ * The transform length is chosen to minimize the cost per output sample.
+ * @param feedforward Feedforward coefficient values, such as those of a `DigitalFilterReal`
+ * @return Constructed filter
+ */
+FastConvolutionReal *fast_convolution_real_make(const VectorReal *feedforward);
+
+/**
+ * @brief 
+ * Evaluates an FFT-based FIR filter over a block of input values.
+ * Each output corresponds to the input at the same position; there is no added latency.
+ * Calls with lengths that are multiples of `fast_convolution_real_block_length` are the most efficient.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void fast_convolution_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    FastConvolutionReal *filter
+);
+
+/**
+ * @brief 
+ * Number of outputs produced by each transform of an FFT-based FIR filter
+ * @param filter Filter
+ * @return Block length
+ */
+size_t fast_convolution_real_block_length(const FastConvolutionReal *filter);
+
+/**
+ * @brief 
+ * Resets an FFT-based FIR filter to its initial state
+ * @param filter Filter to reset
+ */
+void fast_convolution_real_reset(FastConvolutionReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with an FFT-based FIR filter
+ * @param filter Filter to be freed
+ */
+void fast_convolution_real_free(FastConvolutionReal *filter);
+
+/**
+ * @brief 
+ * FFT-based real-valued FIR filter, evaluated with uniformly partitioned overlap-save convolution.
+ * The impulse response is split into partitions of `block_length` taps, 
+ * whose contributions are accumulated from a frequency-domain delay line of past input spectra.
+ * Transform size depends only on the block length, so long filters can be run with small blocks.
+ */
+typedef struct {
+    FftComplex *fft; /** Transform of length `2 * block_length` */
+    double complex *partition_spectra; /** Spectra of each zero-padded impulse response partition, prescaled by the inverse transform length */
+    double complex *spectrum_delay_line; /** Spectra of the most recent completed input frames, stored circularly */
+    double complex *tail_spectrum; /** Contribution of all but the first partition to the current block */
+    double complex *work_area; /** Spectrum of the current input frame. Holds the filtered frame after the inverse transform. */
+    double *input_frame; /** The previous block of inputs, followed by the inputs of the current block */
+    size_t n_partitions; /** Number of impulse response partitions */
+    size_t newest_spectrum_index; /** Index of the most recent spectrum in the delay line */
+    size_t block_length; /** Number of outputs produced per transform */
+    size_t n_pending; /** Number of inputs of the current block received so far */
+} PartitionedConvolutionReal;
+
+/**
+ * @brief 
+ * Makes and allocates a uniformly partitioned FFT-based FIR filter.
+ * @param feedforward Feedforward coefficient values, such as those of a `DigitalFilterReal`
+ * @param block_length Partition length. Must be a power of two.
+ * Smaller blocks reduce the work done per call at the cost of throughput.
+ * @return Constructed filter
+ */
+PartitionedConvolutionReal *partitioned_convolution_real_make(
+    const VectorReal *feedforward, 
+    size_t block_length
+);
+
+/**
+ * @brief 
+ * Evaluates a uniformly partitioned FFT-based FIR filter over a block of input values.
+ * Each output corresponds to the input at the same position; there is no added latency.
+ * Calls with lengths that are multiples of the block length are the most efficient.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void partitioned_convolution_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    PartitionedConvolutionReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a uniformly partitioned FFT-based FIR filter to its initial state
+ * @param filter Filter to reset
+ */
+void partitioned_convolution_real_reset(PartitionedConvolutionReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a uniformly partitioned FFT-based FIR filter
+ * @param filter Filter to be freed
+ */
+void partitioned_convolution_real_free(PartitionedConvolutionReal *filter);
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef QUICKWAVE_FFT
 #define QUICKWAVE_FFT
 
+#include <complex.h>
 #include "vector.h"
 
 typedef struct {
@@ -15,4 +16,20 @@ void fft_free_fft_complex(FftComplex *fft);
 void fft_fft(VectorComplex *data, FftComplex *fft);
 void fft_ifft(VectorComplex *data, FftComplex *fft);
 
+/**
+ * @brief 
+ * Performs an in-place forward FFT of a complex array
+ * @param data Array of `fft->length` elements to be transformed
+ * @param fft FFT configuration
+ */
+void fft_fft_array(double complex data[], FftComplex *fft);
+
+/**
+ * @brief 
+ * Performs an in-place inverse FFT of a complex array, without the 1 / length scaling
+ * @param data Array of `fft->length` elements to be transformed
+ * @param fft FFT configuration
+ */
+void fft_ifft_unscaled_array(double complex data[], FftComplex *fft);
+
 #endif
\ No newline at end of file
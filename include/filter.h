@@ -4,6 +4,7 @@
 #include <complex.h>
 #include "vector.h"
 #include "window.h"
+#include "fft.h"
 
 /**
  * @brief 
@@ -18,15 +19,95 @@ typedef struct {
 
 /**
  * @brief 
- * Real-valued linear filter. Can be IIR or FIR
+ * Symmetry of a set of filter coefficients about their center
+ */
+enum FilterSymmetry {
+    ASYMMETRIC, /** No symmetry */
+    SYMMETRIC, /** Coefficient i equals coefficient n - 1 - i */
+    ANTISYMMETRIC /** Coefficient i is the negative of coefficient n - 1 - i */
+};
+
+/**
+ * @brief 
+ * Designed coefficients held in the process-wide design cache
+ */
+struct FilterDesignCacheEntry;
+
+/**
+ * @brief 
+ * Real-valued linear filter. Can be IIR or FIR.
+ * Linear-phase feedforward terms are detected when the filter is made, 
+ * and evaluated with a folded kernel that needs half the multiplies.
+ * The feedforward terms are immutable once the filter is made.
  */
 typedef struct {
-    VectorReal *feedforward; /** Feedforward (FIR) terms of the filter */
+    const VectorReal *feedforward; /** Feedforward (FIR) terms of the filter. May be shared with other filters. */
     VectorReal *previous_input;
     VectorReal *feedback; /** Feedback (IIR) terms of the filter */
     VectorReal *previous_output;
+    enum FilterSymmetry feedforward_symmetry; /** Symmetry of the feedforward terms */
+    struct FilterDesignCacheEntry *design; /** Cached design that holds the feedforward terms, or NULL if the filter owns them */
 } DigitalFilterReal;
 
+/**
+ * @brief 
+ * Linear filter with real coefficients applied to a complex signal, such as IQ data. Can be IIR or FIR.
+ * Each tap costs two real multiplies instead of a full complex multiply.
+ * Linear-phase feedforward terms are evaluated with a folded kernel, as for `DigitalFilterReal`, 
+ * so they are immutable once the filter is made.
+ */
+typedef struct {
+    const VectorReal *feedforward; /** Feedforward (FIR) terms of the filter. May be shared with other filters. */
+    VectorComplex *previous_input;
+    VectorReal *feedback; /** Feedback (IIR) terms of the filter */
+    VectorComplex *previous_output;
+    enum FilterSymmetry feedforward_symmetry; /** Symmetry of the feedforward terms */
+    struct FilterDesignCacheEntry *design; /** Cached design that holds the feedforward terms, or NULL if the filter owns them */
+} DigitalFilterMixed;
+
+/**
+ * @brief 
+ * Real-valued FIR filter followed by downsampling.
+ * Only the outputs that are kept are computed, 
+ * so each input sample costs 1 / `decimation` of a full filter evaluation.
+ * The feedforward terms are immutable once the filter is made, as for `DigitalFilterReal`.
+ */
+typedef struct {
+    const VectorReal *feedforward; /** Feedforward (FIR) terms of the filter */
+    VectorReal *previous_input;
+    enum FilterSymmetry feedforward_symmetry; /** Symmetry of the feedforward terms */
+    size_t decimation; /** Number of inputs per output */
+    size_t phase; /** Number of inputs received since the last output */
+} DecimatorReal;
+
+/**
+ * @brief 
+ * Bank of real-valued FIR filters that apply the same coefficients to several channels.
+ * The coefficients are stored once, and the delay line holds whole frames of 
+ * channel-interleaved inputs, so each coefficient is applied to all channels with 
+ * one contiguous, vectorizable loop.
+ * The feedforward terms are immutable once the filter bank is made, as for `DigitalFilterReal`.
+ */
+typedef struct {
+    const VectorReal *feedforward; /** Feedforward (FIR) terms, shared by all channels */
+    enum FilterSymmetry feedforward_symmetry; /** Symmetry of the feedforward terms */
+    size_t n_channels; /** Number of channels */
+    size_t capacity; /** Number of frames `previous_input` can hold */
+    size_t oldest_frame; /** Index of the oldest frame of the current window in `previous_input` */
+    double *previous_input; /** Frames of `n_channels` interleaved inputs. The current window is the `n_taps` frames from `oldest_frame`. */
+} DigitalFilterBankReal;
+
+/**
+ * @brief 
+ * Transform and workspace for calculating frequency responses on a uniform grid. 
+ * Made once and reused for any number of filters, so each response needs no allocations.
+ */
+typedef struct {
+    size_t n_points; /** Number of frequencies */
+    FftComplex *fft; /** Transform of length `n_points` */
+    double complex *polynomials; /** Four delay polynomials of `n_points` elements each */
+} FrequencyResponsePlan;
+
 /**
  * @brief 
  * Specifies the nature of the filter stop-band
@@ -54,6 +135,38 @@ double complex filter_evaluate_digital_filter_complex(double complex input, Digi
  */
 double filter_evaluate_digital_filter_real(double input, DigitalFilterReal *filter);
 
+/**
+ * @brief 
+ * Evaluates a complex linear digital filter over a block of input values.
+ * Produces the same output as calling `filter_evaluate_digital_filter_complex` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void filter_process_block_complex(
+    const double complex *input, 
+    double complex *output, 
+    size_t length, 
+    DigitalFilterComplex *filter
+);
+
+/**
+ * @brief 
+ * Evaluates a real linear digital filter over a block of input values.
+ * Produces the same output as calling `filter_evaluate_digital_filter_real` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void filter_process_block_real(
+    const double *input, 
+    double *output, 
+    size_t length, 
+    DigitalFilterReal *filter
+);
+
 /**
  * @brief 
  * Makes and allocates a complex linear digital filter.
@@ -80,7 +193,168 @@ DigitalFilterReal *filter_make_digital_filter_real(
 
 /**
  * @brief 
- * Makes an exponentially weighted moving average (EWMA) filter
+ * Makes and allocates a decimating FIR filter.
+ * Its output is every `decimation`-th output of the equivalent `DigitalFilterReal`, 
+ * starting with the output for the `decimation`-th input.
+ * @param feedforward Feedforward coefficient values, such as those of an anti-aliasing `filter_make_sinc` filter
+ * @param decimation Downsampling factor
+ * @return Constructed filter
+ */
+DecimatorReal *filter_make_decimator(const VectorReal *feedforward, size_t decimation);
+
+/**
+ * @brief 
+ * Evaluates a decimating FIR filter over a block of input values.
+ * The downsampling phase is carried across calls, so blocks may have any length.
+ * @param input Input signal values, oldest first
+ * @param output Filtered and downsampled values. 
+ * Must have room for `(length + decimation - 1) / decimation` values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ * @return Number of output values
+ */
+size_t filter_process_block_decimator(
+    const double *input, 
+    double *output, 
+    size_t length, 
+    DecimatorReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a decimating FIR filter to its initial state
+ * @param filter Filter to be reset
+ */
+void filter_reset_decimator(DecimatorReal *filter);
+
+/**
+ * @brief 
+ * Frees memory associated with a decimating FIR filter
+ * @param filter Filter to be freed
+ */
+void filter_free_decimator(DecimatorReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a multi-channel FIR filter bank. 
+ * Each channel produces the same output as a `DigitalFilterReal` with the same feedforward coefficients.
+ * @param feedforward Feedforward coefficient values, shared by all channels
+ * @param n_channels Number of channels
+ * @return Constructed filter bank
+ */
+DigitalFilterBankReal *filter_make_digital_filter_bank_real(
+    const VectorReal *feedforward, 
+    size_t n_channels
+);
+
+/**
+ * @brief 
+ * Evaluates a multi-channel FIR filter bank for one frame of inputs
+ * @param input Next input value of each channel
+ * @param output Filtered value of each channel. May be the same array as `input`.
+ * @param filter Filter bank to apply
+ */
+void filter_evaluate_digital_filter_bank_real(
+    const double *input, 
+    double *output, 
+    DigitalFilterBankReal *filter
+);
+
+/**
+ * @brief 
+ * Evaluates a multi-channel FIR filter bank over a block of frames
+ * @param input Channel-interleaved input values, oldest frame first
+ * @param output Channel-interleaved filtered values. May be the same array as `input`.
+ * @param n_frames Number of frames
+ * @param filter Filter bank to apply
+ */
+void filter_process_block_digital_filter_bank_real(
+    const double *input, 
+    double *output, 
+    size_t n_frames, 
+    DigitalFilterBankReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a multi-channel FIR filter bank to its initial state
+ * @param filter Filter bank to be reset
+ */
+void filter_reset_digital_filter_bank_real(DigitalFilterBankReal *filter);
+
+/**
+ * @brief 
+ * Frees memory associated with a multi-channel FIR filter bank
+ * @param filter Filter bank to be freed
+ */
+void filter_free_digital_filter_bank_real(DigitalFilterBankReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a linear filter with real coefficients for complex signals
+ * @param feedforward Feedforward coefficient values
+ * @param feedback Feedback coefficient values. May be NULL for an FIR filter.
+ * @return Constructed filter
+ */
+DigitalFilterMixed *filter_make_digital_filter_mixed(
+    const VectorReal *feedforward,
+    const VectorReal *feedback
+);
+
+/**
+ * @brief 
+ * Makes and allocates a filter for complex signals with the same coefficients as a real filter, 
+ * so that designs such as `filter_make_sinc` can be applied to IQ data. 
+ * The real and imaginary parts are each filtered as by the real filter.
+ * Cached designs, from `filter_make_sinc` or `filter_make_savgol`, are shared instead of copied.
+ * @param filter Real filter whose coefficients are used
+ * @return Constructed filter
+ */
+DigitalFilterMixed *filter_make_digital_filter_mixed_from_real(const DigitalFilterReal *filter);
+
+/**
+ * @brief 
+ * Evaluates a linear filter with real coefficients on a complex signal
+ * @param input Next input signal value
+ * @param filter Filter to apply
+ * @return Filtered value
+ */
+double complex filter_evaluate_digital_filter_mixed(double complex input, DigitalFilterMixed *filter);
+
+/**
+ * @brief 
+ * Evaluates a linear filter with real coefficients over a block of complex input values.
+ * Produces the same output as calling `filter_evaluate_digital_filter_mixed` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void filter_process_block_mixed(
+    const double complex *input, 
+    double complex *output, 
+    size_t length, 
+    DigitalFilterMixed *filter
+);
+
+/**
+ * @brief 
+ * Resets a linear filter with real coefficients to its initial state
+ * @param filter Filter to be reset
+ */
+void filter_reset_digital_filter_mixed(DigitalFilterMixed *filter);
+
+/**
+ * @brief 
+ * Frees memory associated with a linear filter with real coefficients
+ * @param filter Filter to be freed
+ */
+void filter_free_digital_filter_mixed(DigitalFilterMixed *filter);
+
+/**
+ * @brief 
+ * Makes an exponentially weighted moving average (EWMA) filter.
+ * `EwmaComplex` is an equivalent that needs no allocations.
  * @param alpha Smoothing factor 0 < alpha < 1. Smaller alpha means more smoothing.
  * @return EWMA filter 
  */
@@ -89,6 +363,7 @@ DigitalFilterComplex *filter_make_ewma(double alpha);
 /**
  * @brief 
  * Makes a first order IIR low-pass filter. This is a variant of the EWMA filter.
+ * `ewma_complex_make_first_order_iir` makes an equivalent that needs no allocations.
  * @param cutoff_frequency Normalized cutoff frequency
  * @return Constructed filter
  */
@@ -96,11 +371,16 @@ DigitalFilterComplex *filter_make_first_order_iir(double cutoff_frequency);
 
 /**
  * @brief 
- * Makes and allocates a windowed-sinc low-pass filter
+ * Makes and allocates a windowed-sinc low-pass filter.
+ * Designs are cached while any filter uses them, 
+ * so filters with the same parameters share one set of coefficients.
+ * The cache is guarded by a C11 mutex. Where C11 threads are unavailable (`__STDC_NO_THREADS__`), 
+ * the cache is single-threaded and filters must not be made or freed concurrently.
  * @param cutoff_frequency Normalized cutoff frequency
  * @param length Number of filter coefficients
  * @param filter_type The type of the filter. Can be low-pass or high-pass
- * @param window Windowing function
+ * @param window Windowing function. A symmetric window, such as `window_hamming_symmetric`, 
+ * makes the filter linear-phase, so it is evaluated with a folded kernel.
  * @return Constructed filter
  */
 DigitalFilterReal *filter_make_sinc(
@@ -112,7 +392,11 @@ DigitalFilterReal *filter_make_sinc(
 
 /**
  * @brief 
- * Makes and allocates Savitzky-Golay (savgol) filter
+ * Makes and allocates Savitzky-Golay (savgol) filter.
+ * Designs are cached while any filter uses them, 
+ * so filters with the same parameters share one set of coefficients.
+ * The cache is guarded by a C11 mutex. Where C11 threads are unavailable (`__STDC_NO_THREADS__`), 
+ * the cache is single-threaded and filters must not be made or freed concurrently.
  * @param filter_length Number of filter coefficients
  * @param derivative Order of the derivative for the returned value. 0 means no derivative. 
  * @param polynomial_order Order of the polynomial used for smoothing. 1 is linear, 2 parabolic, etc.
@@ -148,4 +432,127 @@ void filter_free_digital_filter_complex(DigitalFilterComplex *filter);
  */
 void filter_free_digital_filter_real(DigitalFilterReal *filter);
 
+/**
+ * @brief 
+ * Makes and allocates a plan for calculating frequency responses on a uniform grid of `n_points` frequencies.
+ * Point `k` is at the normalized frequency `k / n_points`. 
+ * Points above `n_points / 2` are negative frequencies.
+ * @param n_points Number of frequencies. Must be a power of two.
+ * @return Constructed plan
+ */
+FrequencyResponsePlan *filter_make_frequency_response_plan(size_t n_points);
+
+/**
+ * @brief 
+ * Frees memory associated with a frequency response plan
+ * @param plan Plan to be freed
+ */
+void filter_free_frequency_response_plan(FrequencyResponsePlan *plan);
+
+/**
+ * @brief 
+ * Calculates the frequency response of a real linear filter on the grid of a plan, 
+ * with one zero-padded FFT of each of the feedforward and feedback terms.
+ * Negative frequencies are the conjugates of the positive ones.
+ * @param filter Filter to analyze
+ * @param plan Plan providing the frequency grid and workspace. 
+ * Must not be used by another response calculation at the same time.
+ * @param response Complex gain at each of the `n_points` frequencies
+ * @param group_delay Group delay in samples at each frequency. Not calculated if NULL. 
+ * Not finite at frequencies where the gain is zero.
+ */
+void filter_frequency_response_real(
+    const DigitalFilterReal *filter, 
+    FrequencyResponsePlan *plan, 
+    double complex *response, 
+    double *group_delay
+);
+
+/**
+ * @brief 
+ * Calculates the frequency response of a complex linear filter on the grid of a plan, 
+ * with one zero-padded FFT of each of the feedforward and feedback terms.
+ * @param filter Filter to analyze
+ * @param plan Plan providing the frequency grid and workspace. 
+ * Must not be used by another response calculation at the same time.
+ * @param response Complex gain at each of the `n_points` frequencies
+ * @param group_delay Group delay in samples at each frequency. Not calculated if NULL. 
+ * Not finite at frequencies where the gain is zero.
+ */
+void filter_frequency_response_complex(
+    const DigitalFilterComplex *filter, 
+    FrequencyResponsePlan *plan, 
+    double complex *response, 
+    double *group_delay
+);
+
+/**
+ * @brief 
+ * Defines a real-valued FIR filter type with a length fixed at compile time, 
+ * along with its functions. 
+ * The coefficients and delay line are stored inline, so the filter is passed by value like `Pid`, 
+ * and every loop has a constant trip count that the compiler can fully unroll and vectorize.
+ * The delay line is stored twice, so the most recent `N` inputs are always contiguous.
+ * 
+ * The definition provides:
+ * - `name name##_make(const VectorReal *feedforward)`, 
+ * which copies `N` coefficients, such as the `feedforward` terms of a `filter_make_*` design
+ * - `double name##_evaluate(double input, name *filter)`
+ * - `void name##_process_block(const double *input, double *output, size_t length, name *filter)`
+ * - `void name##_reset(name *filter)`
+ * @param name Name of the filter type
+ * @param N Number of filter coefficients
+ */
+#define QUICKWAVE_DEFINE_FIR_REAL(name, N) \
+    typedef struct { \
+        double feedforward[N]; /** Feedforward (FIR) terms of the filter */ \
+        double previous_input[2 * (N)]; /** Each input is stored at `position` and `position + N` */ \
+        size_t position; /** Index of the most recent input */ \
+    } name; \
+    \
+    static inline void name##_reset(name *filter) { \
+        assert_not_null(filter); \
+        for (size_t i = 0; i < 2 * (N); i++) { \
+            filter->previous_input[i] = 0.0; \
+        } \
+        filter->position = (N) - 1; \
+    } \
+    \
+    static inline name name##_make(const VectorReal *feedforward) { \
+        assert_valid_vector(feedforward); \
+        assert(vector_length_generic(feedforward) == (N)); \
+        name filter; \
+        for (size_t i = 0; i < (N); i++) { \
+            filter.feedforward[i] = *vector_real_element(i, (VectorReal *) feedforward); \
+        } \
+        name##_reset(&filter); \
+        return filter; \
+    } \
+    \
+    static inline double name##_evaluate(double input, name *filter) { \
+        assert_not_null(filter); \
+        filter->position = filter->position == (N) - 1 ? 0 : filter->position + 1; \
+        filter->previous_input[filter->position] = input; \
+        filter->previous_input[filter->position + (N)] = input; \
+        \
+        const double *window = &filter->previous_input[filter->position + 1]; \
+        double accumulate = 0.0; \
+        for (size_t i = 0; i < (N); i++) { \
+            accumulate += filter->feedforward[i] * window[i]; \
+        } \
+        return accumulate; \
+    } \
+    \
+    static inline void name##_process_block( \
+        const double *input, \
+        double *output, \
+        size_t length, \
+        name *filter \
+    ) { \
+        assert(length == 0 || (input != NULL && output != NULL)); \
+        for (size_t i = 0; i < length; i++) { \
+            output[i] = name##_evaluate(input[i], filter); \
+        } \
+    }
+
 #endif
\ No newline at end of file
@@ -12,6 +12,7 @@
  */
 typedef struct {
     double moving_sum;
+    double inverse_length; /** Reciprocal of the number of elements averaged */
     VectorReal *previous_input;
 } MovingAverageReal;
 
@@ -23,9 +24,69 @@ typedef struct {
  */
 typedef struct {
     double complex moving_sum;
+    double inverse_length; /** Reciprocal of the number of elements averaged */
     VectorComplex *previous_input;
 } MovingAverageComplex;
 
+/**
+ * @brief 
+ * Cascade of real-valued simple moving averages of the same length, approximating a Gaussian smoother.
+ * Each stage keeps an unnormalized running sum, and the histories of all stages share one allocation
+ * and one ring position. The normalization of every stage is folded into one final scale.
+ * The running sums are recomputed exactly from the histories once per window length, so rounding cannot drift.
+ */
+typedef struct {
+    size_t length; /** Number of sequential elements averaged by each stage */
+    size_t n_stages; /** Number of cascaded moving averages */
+    size_t oldest; /** Ring position of the oldest input of every stage */
+    double scale; /** Reciprocal of `length` to the power of `n_stages` */
+    double *moving_sums; /** Running sum of each stage */
+    double *previous_input; /** Ring of the `length` most recent inputs of each stage, one stage after another */
+} MovingAverageCascadeReal;
+
+/**
+ * @brief 
+ * Sliding statistics of a window of real values
+ */
+typedef struct {
+    double mean; /** Mean of the window */
+    double variance; /** Population variance of the window */
+    double standard_deviation; /** Square root of the variance */
+    double rms; /** Root mean square of the window */
+} Statistics;
+
+/**
+ * @brief 
+ * Sliding mean, variance and RMS of a real-valued signal, with one delay line for all of them.
+ * The mean and the sum of squared deviations from it are updated with a Welford-style O(1) step
+ * as each input replaces the oldest, which avoids the cancellation of a running sum of squares.
+ * Both are recomputed exactly from the delay line once per window length, so rounding cannot drift.
+ */
+typedef struct {
+    double mean; /** Mean of the window */
+    double squared_deviation_sum; /** Sum of the squared deviations of the window from its mean */
+    double inverse_length; /** Reciprocal of the window length */
+    size_t n_until_refresh; /** Number of inputs until the statistics are recomputed from the delay line */
+    VectorReal *previous_input; /** The most recent inputs */
+} MovingStatsReal;
+
+/**
+ * @brief 
+ * Sliding mean, variance and RMS of many real-valued channels that are sampled together.
+ * State is stored as structure-of-arrays with the channel index innermost,
+ * so updating every channel for one frame is a straight vectorizable loop.
+ */
+typedef struct {
+    size_t n_channels; /** Number of channels */
+    size_t length; /** Number of frames in the window */
+    size_t oldest_frame; /** Ring position of the oldest frame */
+    size_t n_until_refresh; /** Number of frames until the statistics are recomputed from the delay line */
+    double inverse_length; /** Reciprocal of the window length */
+    double *mean; /** Mean of each channel */
+    double *squared_deviation_sum; /** Sum of the squared deviations of each channel from its mean */
+    double *previous_input; /** Ring of `length` frames of `n_channels` inputs */
+} MovingStatsBankReal;
+
 /**
  * @brief 
  * Makes and allocates a real-valued simple moving average filter
@@ -68,6 +129,38 @@ double complex moving_average_complex_evaluate(
     MovingAverageComplex *filter
 );
 
+/**
+ * @brief 
+ * Evaluates a real-valued moving average filter over a block of input values.
+ * Produces the same output as calling `moving_average_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Moving average filter
+ */
+void moving_average_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    MovingAverageReal *filter
+);
+
+/**
+ * @brief 
+ * Evaluates a complex-valued moving average filter over a block of input values.
+ * Produces the same output as calling `moving_average_complex_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Moving average filter
+ */
+void moving_average_complex_process_block(
+    const double complex *input,
+    double complex *output,
+    size_t length,
+    MovingAverageComplex *filter
+);
+
 /**
  * @brief 
  * Resets real-valued moving average filter to initial state
@@ -96,4 +189,141 @@ void moving_average_real_free(MovingAverageReal *filter);
  */
 void moving_average_complex_free(MovingAverageComplex *filter);
 
+/**
+ * @brief 
+ * Makes and allocates a cascade of real-valued simple moving averages
+ * @param length Number of sequential elements averaged by each stage
+ * @param n_stages Number of cascaded moving averages
+ * @return Constructed filter
+ */
+MovingAverageCascadeReal *moving_average_cascade_real_make(size_t length, size_t n_stages);
+
+/**
+ * @brief 
+ * Evaluates a cascade of moving averages.
+ * The output is delayed by `n_stages * (length - 1) / 2` samples.
+ * @param input Next input signal value
+ * @param filter Moving average cascade
+ * @return Filtered value
+ */
+double moving_average_cascade_real_evaluate(double input, MovingAverageCascadeReal *filter);
+
+/**
+ * @brief 
+ * Evaluates a cascade of moving averages over a block of input values.
+ * Produces the same output as calling `moving_average_cascade_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Moving average cascade
+ */
+void moving_average_cascade_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    MovingAverageCascadeReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a cascade of moving averages to its initial state
+ * @param filter Filter to reset
+ */
+void moving_average_cascade_real_reset(MovingAverageCascadeReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a cascade of moving averages
+ * @param filter Filter to be freed
+ */
+void moving_average_cascade_real_free(MovingAverageCascadeReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a sliding statistics filter
+ * @param length Number of sequential elements in the window
+ * @return Constructed filter
+ */
+MovingStatsReal *moving_stats_real_make(size_t length);
+
+/**
+ * @brief 
+ * Evaluates a sliding statistics filter
+ * @param input Next input signal value
+ * @param filter Sliding statistics filter
+ * @return Statistics of the `length` most recent inputs
+ */
+Statistics moving_stats_real_evaluate(double input, MovingStatsReal *filter);
+
+/**
+ * @brief 
+ * Evaluates a sliding statistics filter over a block of input values.
+ * Produces the same output as calling `moving_stats_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Statistics after each input
+ * @param length Number of input values
+ * @param filter Sliding statistics filter
+ */
+void moving_stats_real_process_block(
+    const double *input,
+    Statistics *output,
+    size_t length,
+    MovingStatsReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a sliding statistics filter to its initial state
+ * @param filter Filter to reset
+ */
+void moving_stats_real_reset(MovingStatsReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a sliding statistics filter
+ * @param filter Filter to be freed
+ */
+void moving_stats_real_free(MovingStatsReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a multi-channel sliding statistics filter
+ * @param length Number of sequential frames in the window
+ * @param n_channels Number of channels
+ * @return Constructed filter
+ */
+MovingStatsBankReal *moving_stats_bank_real_make(size_t length, size_t n_channels);
+
+/**
+ * @brief 
+ * Evaluates a multi-channel sliding statistics filter for one frame.
+ * Each channel produces the same values as a `MovingStatsReal` given that channel alone.
+ * @param input Next input value of each channel
+ * @param mean Mean of each channel
+ * @param variance Population variance of each channel
+ * @param rms Root mean square of each channel. Not calculated if NULL.
+ * @param filter Sliding statistics filter
+ */
+void moving_stats_bank_real_evaluate(
+    const double *input,
+    double *mean,
+    double *variance,
+    double *rms,
+    MovingStatsBankReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a multi-channel sliding statistics filter to its initial state
+ * @param filter Filter to reset
+ */
+void moving_stats_bank_real_reset(MovingStatsBankReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a multi-channel sliding statistics filter
+ * @param filter Filter to be freed
+ */
+void moving_stats_bank_real_free(MovingStatsBankReal *filter);
+
 #endif
\ No newline at end of file
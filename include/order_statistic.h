@@ -0,0 +1,214 @@
+#ifndef QUICKWAVE_ORDER_STATISTIC
+#define QUICKWAVE_ORDER_STATISTIC
+
+#include <stddef.h>
+#include "vector.h"
+
+/**
+ * @brief 
+ * Sliding k-th order statistic of the most recent `length` real inputs, such as a running percentile.
+ * The window is split between a max-heap of the `rank + 1` smallest values and a min-heap of the rest,
+ * and each heap entry is a slot of the input ring, so every update costs O(log length).
+ * Like `MovingAverageReal`, the window starts out filled with zeros.
+ */
+typedef struct {
+    size_t length; /** Number of sequential inputs in the window */
+    size_t rank; /** Zero-based rank of the statistic, from 0 for the minimum to `length - 1` for the maximum */
+    size_t oldest; /** Ring slot of the oldest input, which is replaced next */
+    double *window; /** Ring of the `length` most recent inputs */
+    size_t *heap; /** Ring slots of the max-heap of the `rank + 1` smallest inputs, followed by the min-heap of the rest */
+    size_t *heap_position; /** Position in `heap` of each ring slot */
+} MovingOrderStatisticReal;
+
+/**
+ * @brief 
+ * Sliding median of the most recent `length` real inputs.
+ * For even lengths, this is the mean of the two middle values.
+ */
+typedef MovingOrderStatisticReal MovingMedianReal;
+
+/**
+ * @brief 
+ * Minimum and maximum of a window, with how many samples ago each occurred.
+ * When a value occurs more than once, the age of its most recent occurrence is given.
+ */
+typedef struct {
+    double min; /** Smallest value in the window */
+    double max; /** Largest value in the window */
+    size_t min_age; /** Number of inputs since the minimum, 0 for the most recent input */
+    size_t max_age; /** Number of inputs since the maximum, 0 for the most recent input */
+} MinMax;
+
+/**
+ * @brief 
+ * Ring of inputs with monotonic values, from the extreme of the window at the front to the most recent input at the back
+ */
+typedef struct {
+    double *values; /** Input values */
+    size_t *sample_indices; /** Sample number of each input */
+    size_t front; /** Ring position of the front entry */
+    size_t count; /** Number of entries */
+} MonotonicQueueReal;
+
+/**
+ * @brief 
+ * Sliding minimum and maximum of the most recent `length` real inputs.
+ * Each is tracked by a monotonic queue, where every input is added and removed at most once,
+ * so updates cost O(1) amortized regardless of the window length.
+ * Blocks at least as long as the window use the van Herk/Gil-Werman algorithm instead,
+ * which costs about three comparisons per input and extreme.
+ * Like `MovingAverageReal`, the window starts out filled with zeros.
+ */
+typedef struct {
+    size_t length; /** Number of sequential inputs in the window */
+    size_t n_inputs; /** Sample number of the next input. The initial zeros are samples `0` to `length - 1`. */
+    VectorReal *previous_input; /** The `length` most recent inputs */
+    MonotonicQueueReal max_queue; /** Decreasing queue, with the maximum at the front */
+    MonotonicQueueReal min_queue; /** Increasing queue, with the minimum at the front */
+    double *suffix_values; /** Workspace for the van Herk/Gil-Werman suffix extremes */
+    size_t *suffix_indices; /** Workspace for the sample numbers of the suffix extremes */
+} MovingMinMaxReal;
+
+/**
+ * @brief 
+ * Makes and allocates a sliding order statistic filter
+ * @param length Number of sequential inputs in the window
+ * @param rank Zero-based rank of the statistic to output. Must be less than `length`.
+ * @return Constructed filter
+ */
+MovingOrderStatisticReal *moving_order_statistic_real_make(size_t length, size_t rank);
+
+/**
+ * @brief 
+ * Evaluates a sliding order statistic filter
+ * @param input Next input signal value
+ * @param filter Filter to apply
+ * @return Value of rank `rank` among the `length` most recent inputs
+ */
+double moving_order_statistic_real_evaluate(double input, MovingOrderStatisticReal *filter);
+
+/**
+ * @brief 
+ * Evaluates a sliding order statistic filter over a block of input values.
+ * Produces the same output as calling `moving_order_statistic_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void moving_order_statistic_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    MovingOrderStatisticReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a sliding order statistic filter to its initial state
+ * @param filter Filter to be reset
+ */
+void moving_order_statistic_real_reset(MovingOrderStatisticReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a sliding order statistic filter
+ * @param filter Filter to be freed
+ */
+void moving_order_statistic_real_free(MovingOrderStatisticReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a sliding median filter
+ * @param length Number of sequential inputs in the window
+ * @return Constructed filter
+ */
+MovingMedianReal *moving_median_real_make(size_t length);
+
+/**
+ * @brief 
+ * Evaluates a sliding median filter
+ * @param input Next input signal value
+ * @param filter Filter to apply
+ * @return Median of the `length` most recent inputs
+ */
+double moving_median_real_evaluate(double input, MovingMedianReal *filter);
+
+/**
+ * @brief 
+ * Evaluates a sliding median filter over a block of input values.
+ * Produces the same output as calling `moving_median_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void moving_median_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    MovingMedianReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a sliding median filter to its initial state
+ * @param filter Filter to be reset
+ */
+void moving_median_real_reset(MovingMedianReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a sliding median filter
+ * @param filter Filter to be freed
+ */
+void moving_median_real_free(MovingMedianReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a sliding minimum and maximum filter
+ * @param length Number of sequential inputs in the window
+ * @return Constructed filter
+ */
+MovingMinMaxReal *moving_min_max_real_make(size_t length);
+
+/**
+ * @brief 
+ * Evaluates a sliding minimum and maximum filter
+ * @param input Next input signal value
+ * @param filter Filter to apply
+ * @return Minimum and maximum of the `length` most recent inputs, and their ages
+ */
+MinMax moving_min_max_real_evaluate(double input, MovingMinMaxReal *filter);
+
+/**
+ * @brief 
+ * Evaluates a sliding minimum and maximum filter over a block of input values.
+ * Produces the same output as calling `moving_min_max_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Minimum and maximum after each input
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void moving_min_max_real_process_block(
+    const double *input,
+    MinMax *output,
+    size_t length,
+    MovingMinMaxReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a sliding minimum and maximum filter to its initial state
+ * @param filter Filter to be reset
+ */
+void moving_min_max_real_reset(MovingMinMaxReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a sliding minimum and maximum filter
+ * @param filter Filter to be freed
+ */
+void moving_min_max_real_free(MovingMinMaxReal *filter);
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef QUICKWAVE_QUANTILE_SKETCH
+#define QUICKWAVE_QUANTILE_SKETCH
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief 
+ * Approximate sliding quantiles of a real-valued signal over very long windows, in bounded memory.
+ * The window is a ring of `n_blocks` sub-windows of `block_length` inputs,
+ * each summarized by a histogram with logarithmically spaced buckets.
+ * Histograms merge by addition, so the window histogram is kept as a running sum:
+ * when a sub-window fills, it is added and the oldest is subtracted.
+ * Quantiles are within `relative_accuracy` of an input of the requested rank,
+ * for magnitudes between `min_magnitude` and `max_magnitude`.
+ * Smaller magnitudes are treated as zero, and larger ones are clamped.
+ * Like `MovingAverageReal`, the window starts out filled with zeros.
+ */
+typedef struct {
+    size_t block_length; /** Number of inputs in each sub-window */
+    size_t n_blocks; /** Number of complete sub-windows in the window */
+    size_t n_block_inputs; /** Number of inputs in the sub-window being filled */
+    size_t filling_block; /** Ring position of the sub-window being filled. The next position holds the oldest. */
+    size_t n_magnitude_buckets; /** Number of buckets for each sign */
+    double log_gamma; /** Logarithm of the ratio between successive bucket boundaries */
+    double min_key; /** Bucket key of the smallest tracked magnitude */
+    double *bucket_values; /** Representative magnitude of each bucket */
+    uint32_t *block_counts; /** Histograms of `n_blocks + 1` sub-windows, each with `2 * n_magnitude_buckets + 1` buckets */
+    size_t *cumulative_counts; /** Number of inputs of the complete sub-windows in each bucket and every lower one */
+} QuantileSketchReal;
+
+/**
+ * @brief 
+ * Makes and allocates a sliding quantile sketch.
+ * Memory is about `(n_blocks + 3) * log(max_magnitude / min_magnitude) / relative_accuracy` counts.
+ * @param block_length Number of inputs in each sub-window.
+ * Quantiles change once per sub-window, and updates cost O(1) amortized when this is at least the number of buckets.
+ * @param n_blocks Number of sub-windows in the window
+ * @param relative_accuracy Maximum relative error of a quantile, between 0 and 1
+ * @param min_magnitude Smallest magnitude distinguished from zero
+ * @param max_magnitude Largest magnitude tracked
+ * @return Constructed sketch
+ */
+QuantileSketchReal *quantile_sketch_real_make(
+    size_t block_length,
+    size_t n_blocks,
+    double relative_accuracy,
+    double min_magnitude,
+    double max_magnitude
+);
+
+/**
+ * @brief 
+ * Adds an input to a sliding quantile sketch
+ * @param input Next input signal value
+ * @param sketch Sketch to update
+ */
+void quantile_sketch_real_insert(double input, QuantileSketchReal *sketch);
+
+/**
+ * @brief 
+ * Adds a block of inputs to a sliding quantile sketch.
+ * Produces the same state as calling `quantile_sketch_real_insert` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param length Number of input values
+ * @param sketch Sketch to update
+ */
+void quantile_sketch_real_insert_block(const double *input, size_t length, QuantileSketchReal *sketch);
+
+/**
+ * @brief 
+ * Approximates a quantile of the `n_blocks * block_length` inputs in the most recent complete sub-windows.
+ * Costs O(log) of the number of buckets.
+ * @param probability Fraction of the window at or below the quantile, between 0 and 1
+ * @param sketch Sketch to query
+ * @return Approximate quantile
+ */
+double quantile_sketch_real_quantile(double probability, const QuantileSketchReal *sketch);
+
+/**
+ * @brief 
+ * Adds an input to a sliding quantile sketch and approximates a quantile
+ * @param input Next input signal value
+ * @param probability Fraction of the window at or below the quantile, between 0 and 1
+ * @param sketch Sketch to update
+ * @return Approximate quantile
+ */
+double quantile_sketch_real_evaluate(double input, double probability, QuantileSketchReal *sketch);
+
+/**
+ * @brief 
+ * Resets a sliding quantile sketch to its initial state
+ * @param sketch Sketch to reset
+ */
+void quantile_sketch_real_reset(QuantileSketchReal *sketch);
+
+/**
+ * @brief 
+ * Frees the memory associated with a sliding quantile sketch
+ * @param sketch Sketch to be freed
+ */
+void quantile_sketch_real_free(QuantileSketchReal *sketch);
+
+#endif
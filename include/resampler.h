@@ -0,0 +1,245 @@
+#ifndef QUICKWAVE_RESAMPLER
+#define QUICKWAVE_RESAMPLER
+
+#include <stddef.h>
+#include <complex.h>
+#include "vector.h"
+#include "window.h"
+
+/**
+ * @brief 
+ * Real-valued rational resampler. Changes the sample rate by a factor of
+ * `interpolation / decimation` with a polyphase filter bank.
+ * Only the filter phases needed for each output are evaluated,
+ * so no work is spent on zero-stuffed inputs or discarded outputs.
+ */
+typedef struct {
+    size_t interpolation; /** Upsampling factor L */
+    size_t decimation; /** Downsampling factor M */
+    size_t taps_per_phase; /** Number of coefficients in each polyphase branch */
+    double *phase_coefficients; /** `interpolation` branches of `taps_per_phase` coefficients, each ordered oldest input first */
+    VectorReal *previous_input; /** The `taps_per_phase` most recent inputs */
+    size_t phase; /** Upsampled-rate offset of the next output from the most recent input */
+} RationalResamplerReal;
+
+/**
+ * @brief 
+ * Order of the Lagrange polynomial used by a Farrow interpolator
+ */
+enum FarrowOrder {
+    FARROW_CUBIC = 3, /** Cubic interpolation through 4 samples */
+    FARROW_QUINTIC = 5 /** Quintic interpolation through 6 samples */
+};
+
+/**
+ * @brief 
+ * Real-valued arbitrary-ratio resampler.
+ * Outputs are interpolated with a Farrow structure: 
+ * the polynomial coefficients are computed from the surrounding inputs, 
+ * then evaluated at the fractional output position.
+ * There is no anti-aliasing filter, so this is intended for ratios close to one, 
+ * such as correcting clock drift, or for signals that are already band-limited.
+ */
+typedef struct {
+    enum FarrowOrder order; /** Interpolation polynomial order */
+    VectorReal *previous_input; /** The `order + 1` most recent inputs */
+    double offset; /** Position of the next output, in input samples, relative to the center interval of `previous_input` */
+} FarrowResamplerReal;
+
+/**
+ * @brief 
+ * Complex-valued arbitrary-ratio resampler.
+ * Outputs are interpolated with a Farrow structure: 
+ * the polynomial coefficients are computed from the surrounding inputs, 
+ * then evaluated at the fractional output position.
+ * There is no anti-aliasing filter, so this is intended for ratios close to one, 
+ * such as correcting clock drift, or for signals that are already band-limited.
+ */
+typedef struct {
+    enum FarrowOrder order; /** Interpolation polynomial order */
+    VectorComplex *previous_input; /** The `order + 1` most recent inputs */
+    double offset; /** Position of the next output, in input samples, relative to the center interval of `previous_input` */
+} FarrowResamplerComplex;
+
+/**
+ * @brief 
+ * Makes and allocates a rational resampler from a prototype low-pass filter.
+ * The ratio is reduced to lowest terms.
+ * @param interpolation Upsampling factor L
+ * @param decimation Downsampling factor M
+ * @param prototype Feedforward coefficients of the anti-imaging/anti-aliasing filter,
+ * designed for the upsampled rate with a pass-band gain of L
+ * @return Constructed resampler
+ */
+RationalResamplerReal *resampler_rational_real_make(
+    size_t interpolation,
+    size_t decimation,
+    const VectorReal *prototype
+);
+
+/**
+ * @brief 
+ * Makes and allocates a rational resampler whose prototype is a windowed-sinc low-pass filter,
+ * with its cutoff at the lower of the input and output Nyquist frequencies.
+ * @param interpolation Upsampling factor L
+ * @param decimation Downsampling factor M
+ * @param taps_per_phase Number of input samples each output depends on
+ * @param window Windowing function
+ * @return Constructed resampler
+ */
+RationalResamplerReal *resampler_rational_real_make_sinc(
+    size_t interpolation,
+    size_t decimation,
+    size_t taps_per_phase,
+    WindowFunction window
+);
+
+/**
+ * @brief 
+ * Resamples a block of input values.
+ * The output phase is carried across calls, so blocks may have any length.
+ * @param input Input signal values, oldest first
+ * @param output Resampled values.
+ * Must have room for `(length * interpolation) / decimation + 1` values, using the reduced ratio.
+ * @param length Number of input values
+ * @param resampler Resampler to apply
+ * @return Number of output values
+ */
+size_t resampler_rational_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    RationalResamplerReal *resampler
+);
+
+/**
+ * @brief 
+ * Resets a rational resampler to its initial state
+ * @param resampler Resampler to be reset
+ */
+void resampler_rational_real_reset(RationalResamplerReal *resampler);
+
+/**
+ * @brief 
+ * Frees the memory associated with a rational resampler
+ * @param resampler Resampler to be freed
+ */
+void resampler_rational_real_free(RationalResamplerReal *resampler);
+
+/**
+ * @brief 
+ * Interpolates values of a real circular buffer with a Lagrange polynomial.
+ * More accurate than `vector_real_interpolated_element` for band-limited signals.
+ * @param index Generalized element index to interpolate at. Can be between integer indices.
+ * @param order Interpolation polynomial order
+ * @param buf Buffer to be accessed
+ * @return Interpolated element
+ */
+double resampler_farrow_real_interpolate(
+    double index, 
+    enum FarrowOrder order, 
+    const VectorReal *buf
+);
+
+/**
+ * @brief 
+ * Interpolates values of a complex circular buffer with a Lagrange polynomial.
+ * More accurate than `vector_complex_interpolated_element` for band-limited signals.
+ * @param index Generalized element index to interpolate at. Can be between integer indices.
+ * @param order Interpolation polynomial order
+ * @param buf Buffer to be accessed
+ * @return Interpolated element
+ */
+double complex resampler_farrow_complex_interpolate(
+    double index, 
+    enum FarrowOrder order, 
+    const VectorComplex *buf
+);
+
+/**
+ * @brief 
+ * Makes and allocates a real-valued arbitrary-ratio resampler
+ * @param order Interpolation polynomial order
+ * @return Constructed resampler
+ */
+FarrowResamplerReal *resampler_farrow_real_make(enum FarrowOrder order);
+
+/**
+ * @brief 
+ * Makes and allocates a complex-valued arbitrary-ratio resampler
+ * @param order Interpolation polynomial order
+ * @return Constructed resampler
+ */
+FarrowResamplerComplex *resampler_farrow_complex_make(enum FarrowOrder order);
+
+/**
+ * @brief 
+ * Resamples a block of real input values.
+ * The output position is carried across calls, and the ratio may change from one call to the next.
+ * Output n is the input signal interpolated at input time `n / ratio`, for a constant ratio.
+ * It is produced once the input `(order + 1) / 2` samples later has been received.
+ * @param input Input signal values, oldest first
+ * @param output Resampled values. Must have room for `ceil(length * ratio) + 1` values.
+ * @param length Number of input values
+ * @param ratio Output sample rate divided by input sample rate
+ * @param resampler Resampler to apply
+ * @return Number of output values
+ */
+size_t resampler_farrow_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    double ratio,
+    FarrowResamplerReal *resampler
+);
+
+/**
+ * @brief 
+ * Resamples a block of complex input values.
+ * The output position is carried across calls, and the ratio may change from one call to the next.
+ * Output n is the input signal interpolated at input time `n / ratio`, for a constant ratio.
+ * It is produced once the input `(order + 1) / 2` samples later has been received.
+ * @param input Input signal values, oldest first
+ * @param output Resampled values. Must have room for `ceil(length * ratio) + 1` values.
+ * @param length Number of input values
+ * @param ratio Output sample rate divided by input sample rate
+ * @param resampler Resampler to apply
+ * @return Number of output values
+ */
+size_t resampler_farrow_complex_process_block(
+    const double complex *input,
+    double complex *output,
+    size_t length,
+    double ratio,
+    FarrowResamplerComplex *resampler
+);
+
+/**
+ * @brief 
+ * Resets a real-valued arbitrary-ratio resampler to its initial state
+ * @param resampler Resampler to be reset
+ */
+void resampler_farrow_real_reset(FarrowResamplerReal *resampler);
+
+/**
+ * @brief 
+ * Resets a complex-valued arbitrary-ratio resampler to its initial state
+ * @param resampler Resampler to be reset
+ */
+void resampler_farrow_complex_reset(FarrowResamplerComplex *resampler);
+
+/**
+ * @brief 
+ * Frees the memory associated with a real-valued arbitrary-ratio resampler
+ * @param resampler Resampler to be freed
+ */
+void resampler_farrow_real_free(FarrowResamplerReal *resampler);
+
+/**
+ * @brief 
+ * Frees the memory associated with a complex-valued arbitrary-ratio resampler
+ * @param resampler Resampler to be freed
+ */
+void resampler_farrow_complex_free(FarrowResamplerComplex *resampler);
+
+#endif
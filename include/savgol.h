@@ -1,8 +1,24 @@
+#ifndef QUICKWAVE_SAVGOL
+#define QUICKWAVE_SAVGOL
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief 
+ * How `savgol_filter` estimates the outputs within half a window of either end of the signal
+ */
+enum SavgolMode {
+    SAVGOL_MODE_INTERP, /** Evaluate the polynomial fitted to the first or last window of inputs */
+    SAVGOL_MODE_MIRROR, /** Extend the signal by reflecting it about the end samples */
+    SAVGOL_MODE_NEAREST /** Extend the signal by repeating the end samples */
+};
+
 /**
  * @brief 
  * Calucluates the coefficients of a Savitzky-Golay (savgol) filter.
- * Returns coefficients in canonical order. They must be reversed when used as filter
- * coefficients.
+ * Returns coefficients in canonical order: weight `i` applies to the `i`-th input of the window, 
+ * oldest first. This is the order of filter coefficients, so they are used without reversing.
  * @param i Index of coefficient. Must be greater than or equal to zero
  * @param center Where to center the estimated value. Zero means that it is centered at the middle of the filter
  * @param window Number of filter coefficients. Must be odd
@@ -10,4 +26,46 @@
  * @param derivative Order of the derivative of the estimated value
  * @return Filter coefficient
  */
-double savgol_weight(int i, int center, int window, int polyorder, int derivative);
\ No newline at end of file
+double savgol_weight(int i, int center, int window, int polyorder, int derivative);
+
+/**
+ * @brief 
+ * Calculates all the coefficients of Savitzky-Golay (savgol) filters for every derivative order 
+ * up to `max_derivative`, in O(window × polyorder) time. 
+ * Gram polynomials are generated iteratively for the whole window, instead of recursively per weight.
+ * Returns coefficients in canonical order, as `savgol_weight` does.
+ * @param center Where to center the estimated value. Zero means that it is centered at the middle of the filter
+ * @param window Number of filter coefficients. Must be odd
+ * @param polyorder Order of polynomial used to perform the smoothing. Must be less than `window`
+ * @param max_derivative Highest derivative order to calculate weights for
+ * @param weights Filter coefficients. Must have room for `(max_derivative + 1) * window` values. 
+ * Weight `i` of derivative order `s` is element `s * window + i`.
+ * @return Whether the weights were calculated. Fails only if memory could not be allocated.
+ */
+bool savgol_weights(int center, int window, int polyorder, int max_derivative, double *weights);
+
+/**
+ * @brief 
+ * Smooths or differentiates a recorded signal with a centered Savitzky-Golay filter. 
+ * Unlike a `filter_make_savgol` filter, there is no delay and every input has an output. 
+ * The interior is a sliding convolution computed in blocks, across outputs, so it vectorizes.
+ * @param input Input signal values
+ * @param output Filtered values. Must not overlap `input`.
+ * @param length Number of input values. Must be at least `window`.
+ * @param window Number of filter coefficients. Must be odd
+ * @param polyorder Order of polynomial used to perform the smoothing. Must be less than `window`
+ * @param derivative Order of the derivative of the estimated value, per sample
+ * @param mode How the ends of the signal are handled
+ * @return Whether the signal was filtered. Fails only if memory could not be allocated.
+ */
+bool savgol_filter(
+    const double *input, 
+    double *output, 
+    size_t length, 
+    int window, 
+    int polyorder, 
+    int derivative, 
+    enum SavgolMode mode
+);
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef QUICKWAVE_SPARSE_FILTER
+#define QUICKWAVE_SPARSE_FILTER
+
+#include <stddef.h>
+#include "vector.h"
+#include "window.h"
+
+/**
+ * @brief 
+ * Nonzero coefficient of a sparse FIR filter
+ */
+typedef struct {
+    size_t offset; /** Position of the coefficient in the equivalent dense filter, oldest input first */
+    double coefficient; /** Coefficient value */
+} SparseTap;
+
+/**
+ * @brief 
+ * Real-valued FIR filter that only stores and evaluates its nonzero coefficients.
+ * Produces the same output as a `DigitalFilterReal` with the same feedforward coefficients,
+ * at a cost proportional to the number of nonzero coefficients.
+ * Suited to comb filters and other kernels that are mostly zeros.
+ */
+typedef struct {
+    VectorReal *previous_input; /** The `n_taps` most recent inputs */
+    size_t n_taps; /** Length of the equivalent dense filter */
+    size_t n_nonzero; /** Number of nonzero coefficients */
+    SparseTap taps[]; /** Nonzero coefficients, in order of increasing offset */
+} SparseFilterReal;
+
+/**
+ * @brief 
+ * Real-valued half-band low-pass filter followed by downsampling by 2.
+ * Every other coefficient of a half-band filter is zero, except for the center coefficient of 1/2,
+ * and the nonzero coefficients are symmetric.
+ * Only the outputs that are kept are computed, using mirrored input pairs,
+ * so each output costs about `n_taps / 4` multiplies.
+ */
+typedef struct {
+    VectorReal *previous_input; /** The `n_taps` most recent inputs */
+    size_t n_taps; /** Length of the equivalent dense filter */
+    size_t phase; /** Number of inputs received since the last output */
+    size_t n_folded; /** Number of nonzero coefficients before the center coefficient */
+    double coefficients[]; /** Nonzero coefficients before the center, at even offsets from the oldest input */
+} HalfBandDecimatorReal;
+
+/**
+ * @brief 
+ * Makes and allocates a sparse FIR filter. Coefficients that are exactly zero are skipped.
+ * @param feedforward Feedforward coefficient values, such as those of a `DigitalFilterReal`
+ * @return Constructed filter
+ */
+SparseFilterReal *sparse_filter_real_make(const VectorReal *feedforward);
+
+/**
+ * @brief 
+ * Evaluates a sparse FIR filter
+ * @param input Next input signal value
+ * @param filter Filter to apply
+ * @return Filtered value
+ */
+double sparse_filter_real_evaluate(double input, SparseFilterReal *filter);
+
+/**
+ * @brief 
+ * Evaluates a sparse FIR filter over a block of input values.
+ * Produces the same output as calling `sparse_filter_real_evaluate` on each input in turn.
+ * @param input Input signal values, oldest first
+ * @param output Filtered values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ */
+void sparse_filter_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    SparseFilterReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a sparse FIR filter to its initial state
+ * @param filter Filter to be reset
+ */
+void sparse_filter_real_reset(SparseFilterReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a sparse FIR filter
+ * @param filter Filter to be freed
+ */
+void sparse_filter_real_free(SparseFilterReal *filter);
+
+/**
+ * @brief 
+ * Makes and allocates a windowed-sinc half-band decimator, with its cutoff at a quarter of the input sample rate.
+ * Its output is every second output of the equivalent dense filter,
+ * starting with the output for the second input.
+ * @param length Number of coefficients of the equivalent dense filter.
+ * Must be 3 more than a multiple of 4, so that the outermost coefficients are nonzero.
+ * @param window Windowing function. Only its first half is used, 
+ * so it should be symmetric, such as `window_hamming_symmetric`.
+ * @return Constructed filter
+ */
+HalfBandDecimatorReal *half_band_decimator_real_make(size_t length, WindowFunction window);
+
+/**
+ * @brief 
+ * Evaluates a half-band decimator over a block of input values.
+ * The downsampling phase is carried across calls, so blocks may have any length.
+ * @param input Input signal values, oldest first
+ * @param output Filtered and downsampled values.
+ * Must have room for `(length + 1) / 2` values. May be the same array as `input`.
+ * @param length Number of input values
+ * @param filter Filter to apply
+ * @return Number of output values
+ */
+size_t half_band_decimator_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    HalfBandDecimatorReal *filter
+);
+
+/**
+ * @brief 
+ * Resets a half-band decimator to its initial state
+ * @param filter Filter to be reset
+ */
+void half_band_decimator_real_reset(HalfBandDecimatorReal *filter);
+
+/**
+ * @brief 
+ * Frees the memory associated with a half-band decimator
+ * @param filter Filter to be freed
+ */
+void half_band_decimator_real_free(HalfBandDecimatorReal *filter);
+
+#endif
@@ -6,6 +6,14 @@
 #include "assertions.h"
 #include <stdbool.h>
 
+/**
+ * @brief 
+ * Minimum number of unused elements allocated past the window of a contiguous buffer.
+ * This bounds how often the window is moved back to the start of its allocation,
+ * and is the smallest block shift limit of any contiguous buffer.
+ */
+#define VECTOR_CONTIGUOUS_MINIMUM_HEADROOM 256
+
 #define assert_valid_vector(vector) assert(vector != NULL && vector->elements != NULL)
 
 #define vector_free_generic(vector) \
@@ -13,7 +21,12 @@
 #define vector_shift_generic(input, vector) \
     _Generic((vector), VectorReal*: vector_real_shift, VectorComplex*: vector_complex_shift)(input, vector)
 #define vector_dot_generic(a, b) \
-    _Generic((a), VectorReal*: vector_real_dot, VectorComplex*: vector_complex_dot)(a, b)
+    _Generic((a), \
+        VectorReal*: vector_real_dot, \
+        const VectorReal*: vector_real_dot, \
+        VectorComplex*: vector_complex_dot, \
+        const VectorComplex*: vector_complex_dot \
+    )(a, b)
 #define vector_element_generic(index, vector) \
     _Generic((vector), \
         VectorReal*: vector_real_element, \
@@ -39,6 +52,25 @@
     )(vector)
 #define vector_reset_generic(vector) \
     _Generic((vector), VectorReal*: vector_real_reset, VectorComplex*: vector_complex_reset)(vector)
+#define vector_shift_block_generic(elements, length, vector) \
+    _Generic((vector), \
+        VectorReal*: vector_real_shift_block, \
+        VectorComplex*: vector_complex_shift_block \
+    )(elements, length, vector)
+#define vector_shift_block_limit_generic(vector) \
+    _Generic((vector), \
+        VectorReal*: vector_real_shift_block_limit, \
+        const VectorReal*: vector_real_shift_block_limit, \
+        VectorComplex*: vector_complex_shift_block_limit, \
+        const VectorComplex*: vector_complex_shift_block_limit \
+    )(vector)
+#define vector_contiguous_elements_generic(vector) \
+    _Generic((vector), \
+        VectorReal*: vector_real_contiguous_elements, \
+        const VectorReal*: vector_real_contiguous_elements, \
+        VectorComplex*: vector_complex_contiguous_elements, \
+        const VectorComplex*: vector_complex_contiguous_elements \
+    )(vector)
 
 /**
  * @brief 
@@ -49,6 +81,7 @@ typedef struct {
     size_t n_elements; /** Number of elements in the buffer */
     size_t last_element_index; /** Index for the last element in the buffer. This is shifted as elements are added. */
     bool is_reversed;
+    size_t capacity; /** Number of allocated elements. Larger than `n_elements` for contiguous-window buffers. */
     double complex elements[]; /** Buffer elements */
 } VectorComplex;
 
@@ -61,6 +94,7 @@ typedef struct {
     size_t n_elements; /** Number of elmeents in the buffer */
     size_t last_element_index; /** Index for the last element in the buffer. This is shifted as elements are added. */
     bool is_reversed;
+    size_t capacity; /** Number of allocated elements. Larger than `n_elements` for contiguous-window buffers. */
     double elements[]; /** Buffer elements */
 } VectorReal;
 
@@ -112,6 +146,45 @@ VectorComplex *vector_complex_from_array(size_t size, const double complex eleme
  */
 VectorComplex *vector_complex_new(size_t size);
 
+/**
+ * @brief 
+ * Makes and allocates a new complex circular buffer whose elements are always 
+ * stored contiguously, oldest first. Intended for filter delay lines, 
+ * which are only modified by shifting.
+ * @param size Number of elements in the circular buffer
+ * @return Circular buffer 
+ */
+VectorComplex *vector_complex_new_contiguous(size_t size);
+
+/**
+ * @brief 
+ * Returns the buffer elements as a contiguous array, ordered from index 0 to the last index.
+ * @param buf Buffer to be accessed
+ * @return Pointer to the first element, or NULL if the elements are not stored contiguously
+ */
+double complex *vector_complex_contiguous_elements(const VectorComplex *buf);
+
+/**
+ * @brief 
+ * Shifts a block of elements into a contiguous buffer.
+ * The buffer contents after shifting in the first `k` elements are 
+ * elements `k` through `k + n_elements - 1` of the returned array.
+ * @param elements Elements to be inserted, oldest first
+ * @param length Number of elements to insert. Must not exceed `vector_complex_shift_block_limit`
+ * @param buf Contiguous buffer to be operated on
+ * @return The `n_elements + length` most recently inserted elements, oldest first. 
+ * Valid until the buffer is next modified.
+ */
+const double complex *vector_complex_shift_block(const double complex elements[], size_t length, VectorComplex *buf);
+
+/**
+ * @brief 
+ * Maximum number of elements that can be shifted into a buffer with a single block shift
+ * @param buf Buffer to be operated on
+ * @return Maximum block length. Zero if the buffer is not contiguous.
+ */
+size_t vector_complex_shift_block_limit(const VectorComplex *buf);
+
 VectorComplex *vector_complex_duplicate(const VectorComplex *vector);
 
 
@@ -178,6 +251,45 @@ VectorReal *vector_real_from_array(size_t size, const double elements[]);
  */
 VectorReal *vector_real_new(size_t size);
 
+/**
+ * @brief 
+ * Makes and allocates a new real circular buffer whose elements are always 
+ * stored contiguously, oldest first. Intended for filter delay lines, 
+ * which are only modified by shifting.
+ * @param size Number of elements in the circular buffer
+ * @return Circular buffer 
+ */
+VectorReal *vector_real_new_contiguous(size_t size);
+
+/**
+ * @brief 
+ * Returns the buffer elements as a contiguous array, ordered from index 0 to the last index.
+ * @param buf Buffer to be accessed
+ * @return Pointer to the first element, or NULL if the elements are not stored contiguously
+ */
+double *vector_real_contiguous_elements(const VectorReal *buf);
+
+/**
+ * @brief 
+ * Shifts a block of elements into a contiguous buffer.
+ * The buffer contents after shifting in the first `k` elements are 
+ * elements `k` through `k + n_elements - 1` of the returned array.
+ * @param elements Elements to be inserted, oldest first
+ * @param length Number of elements to insert. Must not exceed `vector_real_shift_block_limit`
+ * @param buf Contiguous buffer to be operated on
+ * @return The `n_elements + length` most recently inserted elements, oldest first. 
+ * Valid until the buffer is next modified.
+ */
+const double *vector_real_shift_block(const double elements[], size_t length, VectorReal *buf);
+
+/**
+ * @brief 
+ * Maximum number of elements that can be shifted into a buffer with a single block shift
+ * @param buf Buffer to be operated on
+ * @return Maximum block length. Zero if the buffer is not contiguous.
+ */
+size_t vector_real_shift_block_limit(const VectorReal *buf);
+
 VectorReal *vector_real_duplicate(const VectorReal *vector);
 
 size_t vector_real_length(const VectorReal *buf);
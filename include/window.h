@@ -16,11 +16,23 @@ double window_rectangular(size_t element_index, size_t window_size);
 
 /**
  * @brief 
- * Evaluates a Hamming window function
+ * Evaluates a periodic Hamming window function, 
+ * whose first element has no mirror image
  * @param element_index Window element last_element_index
  * @param window_size Size of window
  * @return Window value 
  */
 double window_hamming(size_t element_index, size_t window_size);
 
+/**
+ * @brief 
+ * Evaluates a symmetric Hamming window function, 
+ * where element i exactly equals element window_size - 1 - i. 
+ * Windowed filter designs that use it are linear-phase.
+ * @param element_index Window element last_element_index
+ * @param window_size Size of window
+ * @return Window value 
+ */
+double window_hamming_symmetric(size_t element_index, size_t window_size);
+
 #endif
\ No newline at end of file
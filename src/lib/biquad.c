@@ -0,0 +1,397 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <complex.h>
+
+#include "biquad.h"
+#include "filter.h"
+#include "constants.h"
+#include "assertions.h"
+
+/**
+ * @brief 
+ * Frequency band passed by a designed filter
+ */
+enum BiquadBand {
+    BIQUAD_LOW_PASS,
+    BIQUAD_HIGH_PASS,
+    BIQUAD_BAND_PASS
+};
+
+/**
+ * @brief 
+ * Allocates a cascade of second-order sections, without initializing the coefficients
+ * @param n_sections Number of sections
+ * @return Allocated filter
+ */
+static BiquadCascadeReal *biquad_cascade_real_allocate(size_t n_sections);
+
+/**
+ * @brief 
+ * Designs a Chebyshev type I filter with the bilinear transform.
+ * A Butterworth filter is the limit of zero ripple.
+ * @param order Order of the low-pass prototype
+ * @param ripple_db Peak-to-peak pass-band ripple, in decibels. Zero gives a Butterworth filter.
+ * @param band Frequency band passed by the filter
+ * @param low_cutoff_frequency Normalized cutoff frequency. The lower band edge of a band-pass filter.
+ * @param high_cutoff_frequency Normalized upper band edge of a band-pass filter. Ignored otherwise.
+ * @return Constructed filter
+ */
+static BiquadCascadeReal *design_chebyshev(
+    size_t order,
+    double ripple_db,
+    enum BiquadBand band,
+    double low_cutoff_frequency,
+    double high_cutoff_frequency
+);
+
+/**
+ * @brief 
+ * Maps an analog pole to the z-plane with the bilinear transform, for unit sample period
+ * @param pole Analog pole
+ * @return Digital pole
+ */
+static double complex bilinear_transform(double complex pole);
+
+/**
+ * @brief 
+ * Sets the denominator of a section from two digital poles,
+ * which must be real or a complex conjugate pair
+ * @param first_pole Digital pole
+ * @param second_pole Digital pole
+ * @param coefficients Section coefficients
+ */
+static void set_section_poles(
+    double complex first_pole,
+    double complex second_pole,
+    BiquadCoefficients *coefficients
+);
+
+/**
+ * @brief 
+ * Magnitude response of a single section
+ * @param angular_frequency Angular frequency, in radians per sample
+ * @param coefficients Section coefficients
+ * @return Gain
+ */
+static double section_gain(double angular_frequency, const BiquadCoefficients *coefficients);
+
+/**
+ * @brief 
+ * Scales the feedforward coefficients of a section
+ * @param scale Scale factor
+ * @param coefficients Section coefficients
+ */
+static void scale_section(double scale, BiquadCoefficients *coefficients);
+
+BiquadCascadeReal *biquad_cascade_real_make(
+    size_t n_sections,
+    const BiquadCoefficients coefficients[]
+) {
+    assert(n_sections == 0 || coefficients != NULL);
+
+    BiquadCascadeReal *filter = biquad_cascade_real_allocate(n_sections);
+    if (filter == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < n_sections; i++) {
+        filter->sections[i].coefficients = coefficients[i];
+    }
+    biquad_cascade_real_reset(filter);
+    return filter;
+}
+
+double biquad_cascade_real_evaluate(double input, BiquadCascadeReal *filter) {
+    assert_not_null(filter);
+
+    double value = input;
+    for (size_t i = 0; i < filter->n_sections; i++) {
+        BiquadSection *section = &filter->sections[i];
+        const BiquadCoefficients *c = &section->coefficients;
+        double output = c->b0 * value + section->state[0];
+        section->state[0] = c->b1 * value - c->a1 * output + section->state[1];
+        section->state[1] = c->b2 * value - c->a2 * output;
+        value = output;
+    }
+    return value;
+}
+
+void biquad_cascade_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    BiquadCascadeReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    if (filter->n_sections == 0) {
+        for (size_t i = 0; i < length; i++) {
+            output[i] = input[i];
+        }
+        return;
+    }
+
+    /**
+     * @brief 
+     * Each section runs over the whole block before the next one,
+     * keeping its coefficients and state in registers.
+     */
+    const double *section_input = input;
+    for (size_t i = 0; i < filter->n_sections; i++) {
+        BiquadSection *section = &filter->sections[i];
+        BiquadCoefficients c = section->coefficients;
+        double state_0 = section->state[0];
+        double state_1 = section->state[1];
+        for (size_t j = 0; j < length; j++) {
+            double value = section_input[j];
+            double filtered = c.b0 * value + state_0;
+            state_0 = c.b1 * value - c.a1 * filtered + state_1;
+            state_1 = c.b2 * value - c.a2 * filtered;
+            output[j] = filtered;
+        }
+        section->state[0] = state_0;
+        section->state[1] = state_1;
+        section_input = output;
+    }
+}
+
+void biquad_cascade_real_reset(BiquadCascadeReal *filter) {
+    assert_not_null(filter);
+
+    for (size_t i = 0; i < filter->n_sections; i++) {
+        filter->sections[i].state[0] = 0.0;
+        filter->sections[i].state[1] = 0.0;
+    }
+}
+
+void biquad_cascade_real_free(BiquadCascadeReal *filter) {
+    assert_not_null(filter);
+    free(filter);
+}
+
+BiquadCascadeReal *biquad_make_butterworth(
+    size_t order,
+    double cutoff_frequency,
+    enum FilterType filter_type
+) {
+    assert(filter_type == LOW_PASS || filter_type == HIGH_PASS);
+    return design_chebyshev(
+        order,
+        0.0,
+        filter_type == LOW_PASS ? BIQUAD_LOW_PASS : BIQUAD_HIGH_PASS,
+        cutoff_frequency,
+        0.0
+    );
+}
+
+BiquadCascadeReal *biquad_make_butterworth_band_pass(
+    size_t order,
+    double low_cutoff_frequency,
+    double high_cutoff_frequency
+) {
+    return design_chebyshev(
+        order,
+        0.0,
+        BIQUAD_BAND_PASS,
+        low_cutoff_frequency,
+        high_cutoff_frequency
+    );
+}
+
+BiquadCascadeReal *biquad_make_chebyshev(
+    size_t order,
+    double ripple_db,
+    double cutoff_frequency,
+    enum FilterType filter_type
+) {
+    assert(ripple_db > 0);
+    assert(filter_type == LOW_PASS || filter_type == HIGH_PASS);
+    return design_chebyshev(
+        order,
+        ripple_db,
+        filter_type == LOW_PASS ? BIQUAD_LOW_PASS : BIQUAD_HIGH_PASS,
+        cutoff_frequency,
+        0.0
+    );
+}
+
+BiquadCascadeReal *biquad_make_chebyshev_band_pass(
+    size_t order,
+    double ripple_db,
+    double low_cutoff_frequency,
+    double high_cutoff_frequency
+) {
+    assert(ripple_db > 0);
+    return design_chebyshev(
+        order,
+        ripple_db,
+        BIQUAD_BAND_PASS,
+        low_cutoff_frequency,
+        high_cutoff_frequency
+    );
+}
+
+static BiquadCascadeReal *biquad_cascade_real_allocate(size_t n_sections) {
+    BiquadCascadeReal *filter = malloc(
+        sizeof(BiquadCascadeReal) + sizeof(BiquadSection) * n_sections);
+    if (filter == NULL)
+        return NULL;
+
+    filter->n_sections = n_sections;
+    return filter;
+}
+
+static BiquadCascadeReal *design_chebyshev(
+    size_t order,
+    double ripple_db,
+    enum BiquadBand band,
+    double low_cutoff_frequency,
+    double high_cutoff_frequency
+) {
+    assert(order > 0);
+    assert(ripple_db >= 0);
+    assert(low_cutoff_frequency > 0);
+    assert(low_cutoff_frequency < 0.5);
+    if (band == BIQUAD_BAND_PASS) {
+        assert(high_cutoff_frequency > low_cutoff_frequency);
+        assert(high_cutoff_frequency < 0.5);
+    }
+
+    size_t n_sections = band == BIQUAD_BAND_PASS ? order : (order + 1) / 2;
+    BiquadCascadeReal *filter = biquad_cascade_real_allocate(n_sections);
+    if (filter == NULL)
+        return NULL;
+
+    /**
+     * @brief 
+     * Prototype poles lie on an ellipse with semi-axes sinh(mu) and cosh(mu).
+     * Both are one for a Butterworth filter, placing the poles on the unit circle.
+     */
+    double sinh_mu = 1.0;
+    double cosh_mu = 1.0;
+    double pass_band_gain = 1.0;
+    if (ripple_db > 0) {
+        double epsilon = sqrt(pow(10.0, ripple_db / 10.0) - 1.0);
+        double mu = asinh(1.0 / epsilon) / order;
+        sinh_mu = sinh(mu);
+        cosh_mu = cosh(mu);
+        if (order % 2 == 0)
+            pass_band_gain = 1.0 / sqrt(1.0 + epsilon * epsilon);
+    }
+
+    /**
+     * @brief 
+     * Band edges are prewarped so that they are exact after the bilinear transform
+     */
+    double low_cutoff = 2.0 * tan(M_PI * low_cutoff_frequency);
+    double high_cutoff =
+        band == BIQUAD_BAND_PASS ? 2.0 * tan(M_PI * high_cutoff_frequency) : 0.0;
+    double center = sqrt(low_cutoff * high_cutoff);
+    double bandwidth = high_cutoff - low_cutoff;
+
+    double reference_frequency =
+        band == BIQUAD_LOW_PASS ? 0.0 :
+        band == BIQUAD_HIGH_PASS ? M_PI :
+        2.0 * atan(center / 2.0);
+
+    size_t section_index = 0;
+    for (size_t k = 0; k < (order + 1) / 2; k++) {
+        double theta = M_PI * (2.0 * k + 1.0) / (2.0 * order);
+        double complex prototype_pole = CMPLX(-sinh_mu * sin(theta), cosh_mu * cos(theta));
+        bool is_real_pole = 2 * k + 1 == order;
+        if (is_real_pole)
+            prototype_pole = creal(prototype_pole);
+
+        if (band == BIQUAD_BAND_PASS) {
+            /**
+             * @brief 
+             * s -> (s^2 + center^2) / (bandwidth s) maps each prototype pole p
+             * to the roots of s^2 - p bandwidth s + center^2
+             */
+            double complex discriminant = csqrt(
+                prototype_pole * prototype_pole * bandwidth * bandwidth -
+                4.0 * center * center
+            );
+            double complex first_pole =
+                bilinear_transform((prototype_pole * bandwidth + discriminant) / 2.0);
+            double complex second_pole =
+                bilinear_transform((prototype_pole * bandwidth - discriminant) / 2.0);
+
+            if (is_real_pole) {
+                BiquadCoefficients *c = &filter->sections[section_index++].coefficients;
+                set_section_poles(first_pole, second_pole, c);
+                c->b0 = 1.0; c->b1 = 0.0; c->b2 = -1.0;
+            }
+            else {
+                BiquadCoefficients *c = &filter->sections[section_index++].coefficients;
+                set_section_poles(first_pole, conj(first_pole), c);
+                c->b0 = 1.0; c->b1 = 0.0; c->b2 = -1.0;
+
+                c = &filter->sections[section_index++].coefficients;
+                set_section_poles(second_pole, conj(second_pole), c);
+                c->b0 = 1.0; c->b1 = 0.0; c->b2 = -1.0;
+            }
+        }
+        else {
+            double complex analog_pole = band == BIQUAD_LOW_PASS ?
+                low_cutoff * prototype_pole :
+                low_cutoff / prototype_pole;
+            double complex digital_pole = bilinear_transform(analog_pole);
+            double zero_sign = band == BIQUAD_LOW_PASS ? 1.0 : -1.0;
+
+            BiquadCoefficients *c = &filter->sections[section_index++].coefficients;
+            if (is_real_pole) {
+                c->a1 = -creal(digital_pole);
+                c->a2 = 0.0;
+                c->b0 = 1.0; c->b1 = zero_sign; c->b2 = 0.0;
+            }
+            else {
+                set_section_poles(digital_pole, conj(digital_pole), c);
+                c->b0 = 1.0; c->b1 = 2.0 * zero_sign; c->b2 = 1.0;
+            }
+        }
+    }
+    assert(section_index == n_sections);
+
+    for (size_t i = 0; i < n_sections; i++) {
+        BiquadCoefficients *c = &filter->sections[i].coefficients;
+        scale_section(1.0 / section_gain(reference_frequency, c), c);
+    }
+    scale_section(pass_band_gain, &filter->sections[0].coefficients);
+
+    biquad_cascade_real_reset(filter);
+    return filter;
+}
+
+static double complex bilinear_transform(double complex pole) {
+    return (2.0 + pole) / (2.0 - pole);
+}
+
+static void set_section_poles(
+    double complex first_pole,
+    double complex second_pole,
+    BiquadCoefficients *coefficients
+) {
+    coefficients->a1 = -creal(first_pole + second_pole);
+    coefficients->a2 = creal(first_pole * second_pole);
+}
+
+static double section_gain(double angular_frequency, const BiquadCoefficients *coefficients) {
+    double complex delay = cexp(-I * angular_frequency);
+    double complex numerator =
+        coefficients->b0 +
+        coefficients->b1 * delay +
+        coefficients->b2 * delay * delay;
+    double complex denominator =
+        1.0 +
+        coefficients->a1 * delay +
+        coefficients->a2 * delay * delay;
+    return cabs(numerator / denominator);
+}
+
+static void scale_section(double scale, BiquadCoefficients *coefficients) {
+    coefficients->b0 *= scale;
+    coefficients->b1 *= scale;
+    coefficients->b2 *= scale;
+}
@@ -0,0 +1,340 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include "cic.h"
+#include "constants.h"
+#include "assertions.h"
+
+/**
+ * @brief 
+ * Number of integration points per coefficient used by `cic_make_compensator`
+ */
+#define CIC_COMPENSATOR_OVERSAMPLING 64
+
+/**
+ * @brief 
+ * Makes and allocates a CIC decimator or interpolator, which share a layout
+ * @param cic_type Type of the filter, `CicDecimatorReal` or `CicInterpolatorReal`
+ * @param filter Variable to assign the constructed filter to
+ * @param n_stages Number of integrator and comb stages
+ * @param rate Rate change factor R
+ * @param delay Comb delay M
+ * @param dc_gain Gain of the integer output at DC
+ * @param is_gain_compensated Whether the output is divided by `dc_gain`
+ */
+#define CIC_MAKE(cic_type, filter, n_stages, rate, delay, dc_gain, is_gain_compensated) \
+    assert((n_stages) > 0); \
+    assert((rate) > 0); \
+    assert((delay) > 0); \
+    filter = malloc(sizeof(cic_type) + (n_stages) * (1 + (delay)) * sizeof(uint64_t)); \
+    if (filter == NULL) \
+        return NULL; \
+    filter->order = (n_stages); \
+    filter->rate_change = (rate); \
+    filter->differential_delay = (delay); \
+    filter->output_scale = (is_gain_compensated) ? 1.0 / (dc_gain) : 1.0; \
+    cic_reset_state(filter->state, &filter->comb_index, (n_stages), (delay));
+
+/**
+ * @brief 
+ * Checks that the output of a CIC filter fits in the 64-bit accumulators
+ * @param input_bits Number of significant bits of the signed inputs
+ * @param dc_gain Gain of the integer output at DC
+ */
+static void cic_assert_bit_growth(size_t input_bits, double dc_gain);
+
+/**
+ * @brief 
+ * Zeroes the integrators and combs of a CIC filter
+ * @param state Integrators followed by comb delays
+ * @param comb_index Comb ring position to reset
+ * @param order Number of integrator and comb stages
+ * @param differential_delay Comb delay M
+ */
+static void cic_reset_state(
+    uint64_t *state,
+    size_t *comb_index,
+    size_t order,
+    size_t differential_delay
+);
+
+/**
+ * @brief 
+ * Passes a value through the cascade of combs, each subtracting its input from M calls ago
+ * @param value Input to the first comb
+ * @param combs `differential_delay` previous inputs of each comb
+ * @param order Number of comb stages
+ * @param differential_delay Comb delay M
+ * @param comb_index Position in each stage's ring of previous inputs. Advanced by one.
+ * @return Output of the last comb
+ */
+static inline uint64_t cic_comb(
+    uint64_t value,
+    uint64_t *combs,
+    size_t order,
+    size_t differential_delay,
+    size_t *comb_index
+);
+
+/**
+ * @brief 
+ * Converts a wrapped-around accumulator value to its signed value
+ * @param value Accumulator value, in two's complement
+ * @return Signed value
+ */
+static inline double cic_to_double(uint64_t value);
+
+/**
+ * @brief 
+ * Magnitude response of a gain-compensated CIC filter, at the low rate
+ * @param frequency Normalized frequency, at the low rate
+ * @param order Number of stages
+ * @param rate_change Rate change factor R
+ * @param differential_delay Comb delay M
+ * @return Magnitude response
+ */
+static double cic_magnitude_response(
+    double frequency,
+    size_t order,
+    size_t rate_change,
+    size_t differential_delay
+);
+
+CicDecimatorReal *cic_decimator_real_make(
+    size_t order,
+    size_t decimation,
+    size_t differential_delay,
+    size_t input_bits,
+    bool is_gain_compensated
+) {
+    double dc_gain = pow((double) (decimation * differential_delay), (double) order);
+    cic_assert_bit_growth(input_bits, dc_gain);
+
+    CicDecimatorReal *filter;
+    CIC_MAKE(CicDecimatorReal, filter, order, decimation, differential_delay, dc_gain, is_gain_compensated)
+    filter->phase = 0;
+    return filter;
+}
+
+size_t cic_decimator_real_process_block(
+    const int32_t *input,
+    double *output,
+    size_t length,
+    CicDecimatorReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t order = filter->order;
+    uint64_t *integrators = filter->state;
+    uint64_t *combs = &filter->state[order];
+
+    size_t n_outputs = 0;
+    for (size_t i = 0; i < length; i++) {
+        /**
+         * @brief 
+         * Unsigned arithmetic wraps around modulo 2^64 without undefined behaviour.
+         * Overflow in the integrators cancels in the combs as long as the true output fits.
+         */
+        uint64_t value = (uint64_t) (int64_t) input[i];
+        for (size_t k = 0; k < order; k++) {
+            integrators[k] += value;
+            value = integrators[k];
+        }
+
+        filter->phase++;
+        if (filter->phase == filter->rate_change) {
+            filter->phase = 0;
+            value = cic_comb(
+                value, combs, order, filter->differential_delay, &filter->comb_index
+            );
+            output[n_outputs++] = cic_to_double(value) * filter->output_scale;
+        }
+    }
+    return n_outputs;
+}
+
+void cic_decimator_real_reset(CicDecimatorReal *filter) {
+    assert_not_null(filter);
+
+    cic_reset_state(filter->state, &filter->comb_index, filter->order, filter->differential_delay);
+    filter->phase = 0;
+}
+
+void cic_decimator_real_free(CicDecimatorReal *filter) {
+    assert_not_null(filter);
+
+    free(filter);
+}
+
+CicInterpolatorReal *cic_interpolator_real_make(
+    size_t order,
+    size_t interpolation,
+    size_t differential_delay,
+    size_t input_bits,
+    bool is_gain_compensated
+) {
+    double dc_gain =
+        pow((double) (interpolation * differential_delay), (double) order) / interpolation;
+    cic_assert_bit_growth(input_bits, dc_gain);
+
+    CicInterpolatorReal *filter;
+    CIC_MAKE(CicInterpolatorReal, filter, order, interpolation, differential_delay, dc_gain, is_gain_compensated)
+    return filter;
+}
+
+size_t cic_interpolator_real_process_block(
+    const int32_t *input,
+    double *output,
+    size_t length,
+    CicInterpolatorReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t order = filter->order;
+    uint64_t *integrators = filter->state;
+    uint64_t *combs = &filter->state[order];
+
+    size_t n_outputs = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint64_t comb_output = cic_comb(
+            (uint64_t) (int64_t) input[i], combs, order,
+            filter->differential_delay, &filter->comb_index
+        );
+
+        /**
+         * @brief 
+         * The comb output is zero-stuffed, so only the first integrator input of each group is nonzero
+         */
+        for (size_t j = 0; j < filter->rate_change; j++) {
+            uint64_t value = j == 0 ? comb_output : 0;
+            for (size_t k = 0; k < order; k++) {
+                integrators[k] += value;
+                value = integrators[k];
+            }
+            output[n_outputs++] = cic_to_double(value) * filter->output_scale;
+        }
+    }
+    return n_outputs;
+}
+
+void cic_interpolator_real_reset(CicInterpolatorReal *filter) {
+    assert_not_null(filter);
+
+    cic_reset_state(filter->state, &filter->comb_index, filter->order, filter->differential_delay);
+}
+
+void cic_interpolator_real_free(CicInterpolatorReal *filter) {
+    assert_not_null(filter);
+
+    free(filter);
+}
+
+DigitalFilterReal *cic_make_compensator(
+    size_t order,
+    size_t rate_change,
+    size_t differential_delay,
+    double cutoff_frequency,
+    size_t length,
+    WindowFunction window
+) {
+    assert(order > 0);
+    assert(rate_change > 0);
+    assert(differential_delay > 0);
+    assert(cutoff_frequency > 0 && cutoff_frequency < 0.5 / differential_delay);
+    assert((length & 0x1) == 1);
+
+    if (window == NULL)
+        window = window_rectangular;
+
+    VectorReal *feedforward = vector_real_new(length);
+    if (feedforward == NULL)
+        return NULL;
+
+    /**
+     * @brief 
+     * Each coefficient is the inverse Fourier transform of the desired response,
+     * integrated with the midpoint rule. For a flat desired response this is the sinc kernel.
+     * Coefficients are computed for one half and mirrored, so that they are exactly symmetric.
+     */
+    size_t center = length / 2;
+    size_t n_points = CIC_COMPENSATOR_OVERSAMPLING * length;
+    double step = cutoff_frequency / n_points;
+    double uncorrected_dc_gain = 0;
+    for (size_t i = 0; i <= center; i++) {
+        double distance = (double) i - (double) center;
+        double coefficient = 0;
+        for (size_t j = 0; j < n_points; j++) {
+            double frequency = (j + 0.5) * step;
+            coefficient += cos(2 * M_PI * frequency * distance) /
+                cic_magnitude_response(frequency, order, rate_change, differential_delay);
+        }
+
+        coefficient *= 2 * step * window(i, length);
+        *vector_real_element(i, feedforward) = coefficient;
+        *vector_real_element(length - 1 - i, feedforward) = coefficient;
+        uncorrected_dc_gain += i == center ? coefficient : 2 * coefficient;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        *vector_real_element(i, feedforward) /= uncorrected_dc_gain;
+    }
+
+    DigitalFilterReal *filter = filter_make_digital_filter_real(feedforward, NULL);
+    vector_real_free(feedforward);
+    return filter;
+}
+
+static void cic_assert_bit_growth(size_t input_bits, double dc_gain) {
+    assert(input_bits > 0 && input_bits <= 32);
+    assert(input_bits + ceil(log2(dc_gain)) <= 64);
+    (void) input_bits;
+    (void) dc_gain;
+}
+
+static void cic_reset_state(
+    uint64_t *state,
+    size_t *comb_index,
+    size_t order,
+    size_t differential_delay
+) {
+    for (size_t i = 0; i < order * (1 + differential_delay); i++) {
+        state[i] = 0;
+    }
+    *comb_index = 0;
+}
+
+static inline uint64_t cic_comb(
+    uint64_t value,
+    uint64_t *combs,
+    size_t order,
+    size_t differential_delay,
+    size_t *comb_index
+) {
+    for (size_t k = 0; k < order; k++) {
+        uint64_t *previous = &combs[k * differential_delay + *comb_index];
+        uint64_t delayed = *previous;
+        *previous = value;
+        value -= delayed;
+    }
+    *comb_index = (*comb_index + 1) % differential_delay;
+    return value;
+}
+
+static inline double cic_to_double(uint64_t value) {
+    if (value > INT64_MAX)
+        return -(double) (int64_t) ~value - 1;
+    return (double) (int64_t) value;
+}
+
+static double cic_magnitude_response(
+    double frequency,
+    size_t order,
+    size_t rate_change,
+    size_t differential_delay
+) {
+    double response = sin(M_PI * differential_delay * frequency) /
+        (rate_change * differential_delay * sin(M_PI * frequency / rate_change));
+    return pow(fabs(response), (double) order);
+}
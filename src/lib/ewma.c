@@ -0,0 +1,89 @@
+#include <math.h>
+
+#include "ewma.h"
+#include "constants.h"
+#include "assertions.h"
+
+double ewma_alpha_from_cutoff(double cutoff_frequency) {
+    assert(cutoff_frequency < 0.5);
+    assert(cutoff_frequency >= 0);
+    double angular_frequency = ordinary_frequency_to_angular(cutoff_frequency);
+    return cos(angular_frequency) -
+        1 +
+        sqrt(
+            pow(cos(angular_frequency), 2) - 4 * cos(angular_frequency) + 3
+        );
+}
+
+EwmaReal ewma_real_make(double alpha) {
+    assert(alpha >= 0.0);
+    assert(alpha <= 1.0);
+
+    EwmaReal ewma = {
+        .alpha = alpha,
+        .previous_output = 0.0
+    };
+    return ewma;
+}
+
+EwmaReal ewma_real_make_first_order_iir(double cutoff_frequency) {
+    return ewma_real_make(ewma_alpha_from_cutoff(cutoff_frequency));
+}
+
+void ewma_real_process_block(const double *input, double *output, size_t length, EwmaReal *ewma) {
+    assert_not_null(ewma);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    /**
+     * @brief 
+     * The state is kept in a local so it stays in a register across the loop
+     */
+    double alpha = ewma->alpha;
+    double previous_output = ewma->previous_output;
+    for (size_t i = 0; i < length; i++) {
+        previous_output += alpha * (input[i] - previous_output);
+        output[i] = previous_output;
+    }
+    ewma->previous_output = previous_output;
+}
+
+void ewma_real_reset(EwmaReal *ewma) {
+    ewma->previous_output = 0.0;
+}
+
+EwmaComplex ewma_complex_make(double alpha) {
+    assert(alpha >= 0.0);
+    assert(alpha <= 1.0);
+
+    EwmaComplex ewma = {
+        .alpha = alpha,
+        .previous_output = 0.0
+    };
+    return ewma;
+}
+
+EwmaComplex ewma_complex_make_first_order_iir(double cutoff_frequency) {
+    return ewma_complex_make(ewma_alpha_from_cutoff(cutoff_frequency));
+}
+
+void ewma_complex_process_block(
+    const double complex *input,
+    double complex *output,
+    size_t length,
+    EwmaComplex *ewma
+) {
+    assert_not_null(ewma);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    double alpha = ewma->alpha;
+    double complex previous_output = ewma->previous_output;
+    for (size_t i = 0; i < length; i++) {
+        previous_output += alpha * (input[i] - previous_output);
+        output[i] = previous_output;
+    }
+    ewma->previous_output = previous_output;
+}
+
+void ewma_complex_reset(EwmaComplex *ewma) {
+    ewma->previous_output = 0.0;
+}
@@ -0,0 +1,469 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+#include "fast_convolution.h"
+#include "fft.h"
+#include "vector.h"
+#include "assertions.h"
+
+/**
+ * @brief 
+ * Largest transform length considered when choosing the block length
+ */
+#define FAST_CONVOLUTION_MAXIMUM_FFT_LENGTH (1 << 24)
+
+/**
+ * @brief 
+ * Chooses the overlap-save transform length that minimizes the cost per output sample.
+ * @param n_taps Number of filter coefficients
+ * @return Transform length. A power of two.
+ */
+static size_t optimal_fft_length(size_t n_taps);
+
+/**
+ * @brief 
+ * Element-wise product of two spectra
+ * @param a Spectrum
+ * @param b Spectrum
+ * @param product Result. May be the same array as `a` or `b`.
+ * @param length Number of spectrum elements
+ */
+static void multiply_spectra(
+    const double complex *a, 
+    const double complex *b, 
+    double complex *product, 
+    size_t length
+);
+
+/**
+ * @brief 
+ * Adds the element-wise product of two spectra to an accumulated spectrum
+ * @param a Spectrum
+ * @param b Spectrum
+ * @param sum Accumulated spectrum
+ * @param length Number of spectrum elements
+ */
+static void multiply_accumulate_spectra(
+    const double complex *a, 
+    const double complex *b, 
+    double complex *sum, 
+    size_t length
+);
+
+/**
+ * @brief 
+ * Number of spectra stored in the frequency-domain delay line of a partitioned convolution
+ * @param n_partitions Number of impulse response partitions
+ * @return Delay line length
+ */
+static size_t spectrum_delay_line_length(size_t n_partitions);
+
+FastConvolutionReal *fast_convolution_real_make(const VectorReal *feedforward) {
+    assert_valid_vector(feedforward);
+
+    FastConvolutionReal *filter = malloc(sizeof(FastConvolutionReal));
+    if (filter == NULL)
+        goto filter_allocation_failure;
+
+    size_t n_taps = vector_length_generic(feedforward);
+    size_t fft_length = optimal_fft_length(n_taps);
+
+    filter->fft = fft_make_fft_complex(fft_length);
+    if (filter->fft == NULL)
+        goto fft_allocation_failure;
+
+    filter->kernel_spectrum = malloc(sizeof(double complex) * fft_length);
+    if (filter->kernel_spectrum == NULL)
+        goto kernel_spectrum_allocation_failure;
+
+    filter->work_area = malloc(sizeof(double complex) * fft_length);
+    if (filter->work_area == NULL)
+        goto work_area_allocation_failure;
+
+    filter->input_frame = malloc(sizeof(double) * fft_length);
+    if (filter->input_frame == NULL)
+        goto input_frame_allocation_failure;
+
+    filter->n_taps = n_taps;
+    filter->block_length = fft_length - n_taps + 1;
+
+    /**
+     * @brief 
+     * The last feedforward coefficient is applied to the most recent input,
+     * so it is the first term of the impulse response.
+     */
+    for (size_t i = 0; i < fft_length; i++) {
+        filter->kernel_spectrum[i] = i < n_taps ?
+            *vector_real_element(n_taps - 1 - i, (VectorReal *) feedforward) / (double) fft_length :
+            0.0;
+    }
+    fft_fft_array(filter->kernel_spectrum, filter->fft);
+
+    fast_convolution_real_reset(filter);
+    return filter;
+
+    input_frame_allocation_failure:
+        free(filter->work_area);
+    work_area_allocation_failure:
+        free(filter->kernel_spectrum);
+    kernel_spectrum_allocation_failure:
+        fft_free_fft_complex(filter->fft);
+    fft_allocation_failure:
+        free(filter);
+    filter_allocation_failure:
+        return NULL;
+}
+
+void fast_convolution_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    FastConvolutionReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t history_length = filter->n_taps - 1;
+    size_t fft_length = history_length + filter->block_length;
+
+    while (length > 0) {
+        size_t n_new = filter->block_length - filter->n_pending;
+        if (n_new > length)
+            n_new = length;
+
+        memcpy(
+            &filter->input_frame[history_length + filter->n_pending],
+            input,
+            sizeof(double) * n_new
+        );
+        filter->n_pending += n_new;
+
+        /**
+         * @brief 
+         * Each output only depends on the inputs at or before its own position in the frame,
+         * so the unfilled remainder of a partial block does not need to be cleared.
+         */
+        for (size_t i = 0; i < fft_length; i++) {
+            filter->work_area[i] = filter->input_frame[i];
+        }
+        fft_fft_array(filter->work_area, filter->fft);
+        multiply_spectra(
+            filter->work_area, 
+            filter->kernel_spectrum, 
+            filter->work_area, 
+            fft_length
+        );
+        fft_ifft_unscaled_array(filter->work_area, filter->fft);
+
+        const double complex *filtered =
+            &filter->work_area[history_length + filter->n_pending - n_new];
+        for (size_t i = 0; i < n_new; i++) {
+            output[i] = creal(filtered[i]);
+        }
+
+        if (filter->n_pending == filter->block_length) {
+            memmove(
+                filter->input_frame,
+                &filter->input_frame[filter->block_length],
+                sizeof(double) * history_length
+            );
+            filter->n_pending = 0;
+        }
+
+        input += n_new;
+        output += n_new;
+        length -= n_new;
+    }
+}
+
+size_t fast_convolution_real_block_length(const FastConvolutionReal *filter) {
+    assert_not_null(filter);
+    return filter->block_length;
+}
+
+void fast_convolution_real_reset(FastConvolutionReal *filter) {
+    assert_not_null(filter);
+
+    size_t fft_length = filter->n_taps - 1 + filter->block_length;
+    for (size_t i = 0; i < fft_length; i++) {
+        filter->input_frame[i] = 0.0;
+    }
+    filter->n_pending = 0;
+}
+
+void fast_convolution_real_free(FastConvolutionReal *filter) {
+    assert_not_null(filter);
+
+    free(filter->input_frame);
+    free(filter->work_area);
+    free(filter->kernel_spectrum);
+    fft_free_fft_complex(filter->fft);
+    free(filter);
+}
+
+PartitionedConvolutionReal *partitioned_convolution_real_make(
+    const VectorReal *feedforward, 
+    size_t block_length
+) {
+    assert_valid_vector(feedforward);
+    assert(block_length > 0);
+    assert((block_length & (block_length - 1)) == 0);
+
+    PartitionedConvolutionReal *filter = malloc(sizeof(PartitionedConvolutionReal));
+    if (filter == NULL)
+        goto filter_allocation_failure;
+
+    size_t n_taps = vector_length_generic(feedforward);
+    size_t fft_length = 2 * block_length;
+    size_t n_partitions = (n_taps + block_length - 1) / block_length;
+    size_t delay_line_length = spectrum_delay_line_length(n_partitions);
+
+    filter->fft = fft_make_fft_complex(fft_length);
+    if (filter->fft == NULL)
+        goto fft_allocation_failure;
+
+    filter->partition_spectra = malloc(sizeof(double complex) * fft_length * n_partitions);
+    if (filter->partition_spectra == NULL)
+        goto partition_spectra_allocation_failure;
+
+    filter->spectrum_delay_line = 
+        malloc(sizeof(double complex) * fft_length * delay_line_length);
+    if (filter->spectrum_delay_line == NULL)
+        goto spectrum_delay_line_allocation_failure;
+
+    filter->tail_spectrum = malloc(sizeof(double complex) * fft_length);
+    if (filter->tail_spectrum == NULL)
+        goto tail_spectrum_allocation_failure;
+
+    filter->work_area = malloc(sizeof(double complex) * fft_length);
+    if (filter->work_area == NULL)
+        goto work_area_allocation_failure;
+
+    filter->input_frame = malloc(sizeof(double) * fft_length);
+    if (filter->input_frame == NULL)
+        goto input_frame_allocation_failure;
+
+    filter->n_partitions = n_partitions;
+    filter->block_length = block_length;
+
+    for (size_t partition = 0; partition < n_partitions; partition++) {
+        double complex *spectrum = &filter->partition_spectra[partition * fft_length];
+        for (size_t i = 0; i < fft_length; i++) {
+            size_t tap = partition * block_length + i;
+            spectrum[i] = i < block_length && tap < n_taps ?
+                *vector_real_element(n_taps - 1 - tap, (VectorReal *) feedforward) / 
+                    (double) fft_length :
+                0.0;
+        }
+        fft_fft_array(spectrum, filter->fft);
+    }
+
+    partitioned_convolution_real_reset(filter);
+    return filter;
+
+    input_frame_allocation_failure:
+        free(filter->work_area);
+    work_area_allocation_failure:
+        free(filter->tail_spectrum);
+    tail_spectrum_allocation_failure:
+        free(filter->spectrum_delay_line);
+    spectrum_delay_line_allocation_failure:
+        free(filter->partition_spectra);
+    partition_spectra_allocation_failure:
+        fft_free_fft_complex(filter->fft);
+    fft_allocation_failure:
+        free(filter);
+    filter_allocation_failure:
+        return NULL;
+}
+
+void partitioned_convolution_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    PartitionedConvolutionReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t block_length = filter->block_length;
+    size_t fft_length = 2 * block_length;
+    size_t delay_line_length = spectrum_delay_line_length(filter->n_partitions);
+
+    while (length > 0) {
+        size_t n_new = block_length - filter->n_pending;
+        if (n_new > length)
+            n_new = length;
+
+        memcpy(
+            &filter->input_frame[block_length + filter->n_pending],
+            input,
+            sizeof(double) * n_new
+        );
+        filter->n_pending += n_new;
+
+        for (size_t i = 0; i < fft_length; i++) {
+            filter->work_area[i] = filter->input_frame[i];
+        }
+        fft_fft_array(filter->work_area, filter->fft);
+
+        bool is_block_complete = filter->n_pending == block_length;
+        if (is_block_complete && filter->n_partitions > 1) {
+            filter->newest_spectrum_index = 
+                (filter->newest_spectrum_index + 1) % delay_line_length;
+            memcpy(
+                &filter->spectrum_delay_line[filter->newest_spectrum_index * fft_length],
+                filter->work_area,
+                sizeof(double complex) * fft_length
+            );
+        }
+
+        /**
+         * @brief 
+         * Only the first partition sees the current, possibly partial, block.
+         * The remaining partitions were accumulated when the previous block completed.
+         */
+        multiply_spectra(
+            filter->work_area, 
+            filter->partition_spectra, 
+            filter->work_area, 
+            fft_length
+        );
+        for (size_t i = 0; i < fft_length; i++) {
+            filter->work_area[i] += filter->tail_spectrum[i];
+        }
+        fft_ifft_unscaled_array(filter->work_area, filter->fft);
+
+        const double complex *filtered =
+            &filter->work_area[block_length + filter->n_pending - n_new];
+        for (size_t i = 0; i < n_new; i++) {
+            output[i] = creal(filtered[i]);
+        }
+
+        if (is_block_complete) {
+            for (size_t i = 0; i < fft_length; i++) {
+                filter->tail_spectrum[i] = 0.0;
+            }
+            for (size_t partition = 1; partition < filter->n_partitions; partition++) {
+                size_t spectrum_index = 
+                    (filter->newest_spectrum_index + delay_line_length - (partition - 1)) % 
+                    delay_line_length;
+                multiply_accumulate_spectra(
+                    &filter->spectrum_delay_line[spectrum_index * fft_length],
+                    &filter->partition_spectra[partition * fft_length],
+                    filter->tail_spectrum,
+                    fft_length
+                );
+            }
+
+            memcpy(
+                filter->input_frame,
+                &filter->input_frame[block_length],
+                sizeof(double) * block_length
+            );
+            filter->n_pending = 0;
+        }
+
+        input += n_new;
+        output += n_new;
+        length -= n_new;
+    }
+}
+
+void partitioned_convolution_real_reset(PartitionedConvolutionReal *filter) {
+    assert_not_null(filter);
+
+    size_t fft_length = 2 * filter->block_length;
+    size_t delay_line_length = spectrum_delay_line_length(filter->n_partitions);
+    for (size_t i = 0; i < fft_length * delay_line_length; i++) {
+        filter->spectrum_delay_line[i] = 0.0;
+    }
+    for (size_t i = 0; i < fft_length; i++) {
+        filter->tail_spectrum[i] = 0.0;
+        filter->input_frame[i] = 0.0;
+    }
+    filter->newest_spectrum_index = 0;
+    filter->n_pending = 0;
+}
+
+void partitioned_convolution_real_free(PartitionedConvolutionReal *filter) {
+    assert_not_null(filter);
+
+    free(filter->input_frame);
+    free(filter->work_area);
+    free(filter->tail_spectrum);
+    free(filter->spectrum_delay_line);
+    free(filter->partition_spectra);
+    fft_free_fft_complex(filter->fft);
+    free(filter);
+}
+
+static void multiply_spectra(
+    const double complex *a, 
+    const double complex *b, 
+    double complex *product, 
+    size_t length
+) {
+    for (size_t i = 0; i < length; i++) {
+        double a_real = creal(a[i]);
+        double a_imag = cimag(a[i]);
+        double b_real = creal(b[i]);
+        double b_imag = cimag(b[i]);
+        product[i] = CMPLX(
+            a_real * b_real - a_imag * b_imag,
+            a_real * b_imag + a_imag * b_real
+        );
+    }
+}
+
+static void multiply_accumulate_spectra(
+    const double complex *a, 
+    const double complex *b, 
+    double complex *sum, 
+    size_t length
+) {
+    for (size_t i = 0; i < length; i++) {
+        double a_real = creal(a[i]);
+        double a_imag = cimag(a[i]);
+        double b_real = creal(b[i]);
+        double b_imag = cimag(b[i]);
+        sum[i] = CMPLX(
+            creal(sum[i]) + a_real * b_real - a_imag * b_imag,
+            cimag(sum[i]) + a_real * b_imag + a_imag * b_real
+        );
+    }
+}
+
+static size_t spectrum_delay_line_length(size_t n_partitions) {
+    return n_partitions > 1 ? n_partitions - 1 : 1;
+}
+
+static size_t optimal_fft_length(size_t n_taps) {
+    assert(n_taps > 0);
+
+    size_t fft_length = 4;
+    while (fft_length < 2 * n_taps) {
+        fft_length *= 2;
+    }
+
+    /**
+     * @brief 
+     * A transform of length F costs roughly F log2(F) operations
+     * and yields F - n_taps + 1 outputs.
+     */
+    size_t best_fft_length = fft_length;
+    double best_cost = INFINITY;
+    for (; fft_length <= FAST_CONVOLUTION_MAXIMUM_FFT_LENGTH; fft_length *= 2) {
+        double cost =
+            fft_length * (log2((double) fft_length) + 1) /
+            (double) (fft_length - n_taps + 1);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_fft_length = fft_length;
+        }
+    }
+    return best_fft_length;
+}
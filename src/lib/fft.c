@@ -26,6 +26,11 @@ FftComplex *fft_make_fft_complex(int length) {
     fft->bit_reversal_work_area = malloc(sizeof(int) * bit_reversal_work_area_length);
     if (fft->bit_reversal_work_area == NULL)
         goto bit_reversal_allocation_failure;
+    /**
+     * @brief 
+     * The wave table is computed by the first transform when this is zero
+     */
+    fft->bit_reversal_work_area[0] = 0;
     
     fft->wave_table = malloc(sizeof(double) * (length / 2));
     if (fft->wave_table == NULL)
@@ -87,6 +92,32 @@ void fft_ifft(VectorComplex *data, FftComplex *fft) {
     vector_complex_scale(1.0 / vector_length_generic(data), data);
 }
 
+void fft_fft_array(double complex data[], FftComplex *fft) {
+    assert_not_null(data);
+    assert_not_null(fft);
+
+    cdft(
+        fft->length * 2, 
+        FORWARD_TRANSFORM, 
+        (double *) data, 
+        fft->bit_reversal_work_area, 
+        fft->wave_table
+    );
+}
+
+void fft_ifft_unscaled_array(double complex data[], FftComplex *fft) {
+    assert_not_null(data);
+    assert_not_null(fft);
+
+    cdft(
+        fft->length * 2, 
+        UNSCALED_INVERSE_TRANSFORM, 
+        (double *) data, 
+        fft->bit_reversal_work_area, 
+        fft->wave_table
+    );
+}
+
 static bool is_power_of_two(int n) {
     return (n & (n - 1)) == 0;
 }
\ No newline at end of file
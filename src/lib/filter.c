@@ -1,11 +1,25 @@
 #include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include <math.h>
 #include <complex.h>
 #include "savgol.h"
+#include "fft.h"
 #include "filter.h"
+#include "ewma.h"
 #include "constants.h"
 #include "assertions.h"
 
+/**
+ * @brief 
+ * C11 threads are only used to guard the design cache. 
+ * Without them the cache is not thread-safe.
+ */
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
+
 /**
  * @brief 
  * Normalized sinc function
@@ -22,17 +36,366 @@ double sinc(double x);
  */
 double dirac_delta(double x);
 
+/**
+ * @brief 
+ * Kind of coefficient design held in the design cache
+ */
+enum FilterDesign {
+    FILTER_DESIGN_SINC, /** Windowed-sinc filter */
+    FILTER_DESIGN_SAVGOL /** Savitzky-Golay filter */
+};
+
+/**
+ * @brief 
+ * Parameters that identify a coefficient design. 
+ * Parameters that do not apply to the design are zero.
+ */
+typedef struct {
+    enum FilterDesign design; /** Kind of design */
+    size_t length; /** Number of filter coefficients */
+    double cutoff_frequency; /** Normalized cutoff frequency of a sinc filter */
+    int derivative; /** Derivative order of a savgol filter */
+    int polynomial_order; /** Polynomial order of a savgol filter */
+    enum FilterType filter_type; /** Low-pass or high-pass sinc filter */
+    WindowFunction *window; /** Windowing function of a sinc filter */
+} FilterDesignKey;
+
+/**
+ * @brief 
+ * Designed coefficients, shared by every filter made with the same parameters
+ */
+typedef struct FilterDesignCacheEntry {
+    FilterDesignKey key; /** Design parameters */
+    VectorReal *coefficients; /** Designed coefficients. Never modified. */
+    size_t n_references; /** Number of filters using the coefficients. The entry is freed when it reaches zero. */
+    struct FilterDesignCacheEntry *next; /** Next entry of the same hash bucket */
+} FilterDesignCacheEntry;
+
+/**
+ * @brief 
+ * Number of hash buckets of the design cache
+ */
+#define DESIGN_CACHE_N_BUCKETS 64
+
+/**
+ * @brief 
+ * Process-wide cache of designed coefficients, as a hash table guarded by `design_cache_lock`
+ */
+static FilterDesignCacheEntry *design_cache[DESIGN_CACHE_N_BUCKETS];
+#ifndef __STDC_NO_THREADS__
+static mtx_t design_cache_mutex;
+static bool design_cache_mutex_initialized;
+static once_flag design_cache_once = ONCE_FLAG_INIT;
+
+/**
+ * @brief 
+ * Initializes the design cache lock and records whether it succeeded. Called once.
+ */
+static void design_cache_initialize(void);
+#endif
+
+/**
+ * @brief 
+ * Locks the design cache. Without C11 threads this does nothing, and the cache is single-threaded.
+ * @return Whether the cache was locked. False if the lock could not be initialized.
+ */
+static bool design_cache_lock(void);
+
+/**
+ * @brief 
+ * Unlocks the design cache
+ */
+static void design_cache_unlock(void);
+
+/**
+ * @brief 
+ * Finds designed coefficients in the cache, designing and adding them if they are not present.
+ * The caller holds a reference to the returned entry, which it gives up with `design_cache_release`.
+ * @param key Design parameters
+ * @return Cache entry, or NULL if the coefficients could not be designed
+ */
+static FilterDesignCacheEntry *design_cache_acquire(const FilterDesignKey *key);
+
+/**
+ * @brief 
+ * Takes another reference to designed coefficients that the caller already holds a reference to
+ * @param entry Cache entry from `design_cache_acquire`
+ */
+static void design_cache_retain(FilterDesignCacheEntry *entry);
+
+/**
+ * @brief 
+ * Gives up a reference to designed coefficients, freeing them if no other filter uses them
+ * @param entry Cache entry from `design_cache_acquire`
+ */
+static void design_cache_release(FilterDesignCacheEntry *entry);
+
+/**
+ * @brief 
+ * Finds designed coefficients in the cache. The cache must be locked.
+ * @param key Design parameters
+ * @param bucket Hash bucket of the design parameters
+ * @return Cache entry, or NULL if the design is not in the cache
+ */
+static FilterDesignCacheEntry *design_cache_find(const FilterDesignKey *key, size_t bucket);
+
+/**
+ * @brief 
+ * Finds the hash bucket of design parameters
+ * @param key Design parameters
+ * @return Hash bucket
+ */
+static size_t design_key_bucket(const FilterDesignKey *key);
+
+/**
+ * @brief 
+ * Compares design parameters
+ * @param a Design parameters
+ * @param b Design parameters
+ * @return Whether the designs are the same
+ */
+static bool design_key_equal(const FilterDesignKey *a, const FilterDesignKey *b);
+
+/**
+ * @brief 
+ * Calculates Savitzky-Golay filter coefficients
+ * @param filter_length Number of filter coefficients. Must be odd.
+ * @param derivative Order of the derivative of the estimated value
+ * @param polynomial_order Order of the polynomial used for smoothing
+ * @return Coefficients, oldest input first
+ */
+static VectorReal *design_savgol(
+    size_t filter_length, 
+    int derivative, 
+    int polynomial_order
+);
+
+/**
+ * @brief 
+ * Calculates windowed-sinc filter coefficients
+ * @param cutoff_frequency Normalized cutoff frequency
+ * @param length Number of filter coefficients. Must be odd.
+ * @param filter_type The type of the filter. Can be low-pass or high-pass
+ * @param window Windowing function
+ * @return Coefficients, oldest input first
+ */
+static VectorReal *design_sinc(
+    double cutoff_frequency, 
+    size_t length, 
+    enum FilterType filter_type,
+    WindowFunction window
+);
+
+/**
+ * @brief 
+ * Makes and allocates an FIR filter that references cached coefficients instead of copying them
+ * @param design Cache entry holding the feedforward coefficients. 
+ * The filter takes over the caller's reference, and gives it up if it cannot be made.
+ * @return Constructed filter
+ */
+static DigitalFilterReal *filter_make_shared_fir_real(FilterDesignCacheEntry *design);
+
+/**
+ * @brief 
+ * Maximum number of outputs computed together by the block FIR kernels.
+ * Sized so that the accumulators stay resident in L1 cache.
+ */
+#define FILTER_BLOCK_LENGTH 256
+
+/**
+ * @brief 
+ * Evaluates a real FIR filter over a block of inputs.
+ * Taps are accumulated in the same order as `vector_real_dot`, 
+ * so results are identical to per-sample evaluation.
+ * @param coefficients Filter coefficients, oldest input first
+ * @param n_taps Number of filter coefficients
+ * @param history Input history. Output `k` is computed from elements `k` through `k + n_taps - 1`.
+ * @param output Filtered values
+ * @param length Number of outputs. Must not exceed `FILTER_BLOCK_LENGTH`.
+ */
+static void fir_block_real(
+    const double *restrict coefficients,
+    size_t n_taps,
+    const double *restrict history,
+    double *restrict output,
+    size_t length
+);
+
+/**
+ * @brief 
+ * Evaluates a complex FIR filter over a block of inputs.
+ * Taps are accumulated in the same order as `vector_complex_dot`, 
+ * so results are identical to per-sample evaluation.
+ * @param coefficients Filter coefficients, oldest input first
+ * @param n_taps Number of filter coefficients
+ * @param history Input history. Output `k` is computed from elements `k` through `k + n_taps - 1`.
+ * @param output Filtered values
+ * @param length Number of outputs. Must not exceed `FILTER_BLOCK_LENGTH`.
+ */
+static void fir_block_complex(
+    const double complex *restrict coefficients,
+    size_t n_taps,
+    const double complex *restrict history,
+    double complex *restrict output,
+    size_t length
+);
+
+/**
+ * @brief 
+ * Evaluates a linear-phase real FIR filter over a block of inputs. 
+ * Mirrored inputs are added or subtracted before multiplying, 
+ * so only the first half of the coefficients is used.
+ * Taps are accumulated in the same order as `fir_folded_real`, 
+ * so results are identical to per-sample evaluation.
+ * @param coefficients Filter coefficients, oldest input first
+ * @param n_taps Number of filter coefficients
+ * @param symmetry Symmetry of the coefficients. Must not be `ASYMMETRIC`.
+ * @param history Input history. Output `k` is computed from elements `k` through `k + n_taps - 1`.
+ * @param output Filtered values
+ * @param length Number of outputs. Must not exceed `FILTER_BLOCK_LENGTH`.
+ */
+static void fir_block_folded_real(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    const double *restrict history,
+    double *restrict output,
+    size_t length
+);
+
+/**
+ * @brief 
+ * Evaluates a linear-phase real FIR filter for a single output
+ * @param coefficients Filter coefficients, oldest input first
+ * @param n_taps Number of filter coefficients
+ * @param symmetry Symmetry of the coefficients. Must not be `ASYMMETRIC`.
+ * @param window The `n_taps` most recent inputs, oldest first
+ * @return Filtered value
+ */
+static double fir_folded_real(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    const double *restrict window
+);
+
+/**
+ * @brief 
+ * Evaluates a real FIR filter for one frame of channel-interleaved inputs.
+ * Each channel is accumulated in the same order as a `DigitalFilterReal` with the same coefficients.
+ * @param coefficients Filter coefficients, oldest input first
+ * @param n_taps Number of filter coefficients
+ * @param symmetry Symmetry of the coefficients
+ * @param n_channels Number of channels
+ * @param window The `n_taps` most recent frames, oldest first
+ * @param output Filtered value of each channel
+ */
+static void fir_bank_real(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    size_t n_channels,
+    const double *restrict window,
+    double *restrict output
+);
+
+/**
+ * @brief 
+ * Evaluates a filter with real coefficients on a complex signal for a single output.
+ * The real and imaginary parts are accumulated separately, without complex multiplies.
+ * @param coefficients Filter coefficients, oldest input first
+ * @param n_taps Number of filter coefficients
+ * @param symmetry Symmetry of the coefficients
+ * @param window The `n_taps` most recent inputs, oldest first
+ * @return Filtered value
+ */
+static double complex fir_mixed(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    const double complex *restrict window
+);
+
+/**
+ * @brief 
+ * Evaluates a filter with real coefficients on a complex signal over a block of inputs.
+ * Taps are accumulated in the same order as `fir_mixed`, 
+ * so results are identical to per-sample evaluation.
+ * @param coefficients Filter coefficients, oldest input first
+ * @param n_taps Number of filter coefficients
+ * @param symmetry Symmetry of the coefficients
+ * @param history Input history. Output `k` is computed from elements `k` through `k + n_taps - 1`.
+ * @param output Filtered values
+ * @param length Number of outputs. Must not exceed `FILTER_BLOCK_LENGTH`.
+ */
+static void fir_block_mixed(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    const double complex *restrict history,
+    double complex *restrict output,
+    size_t length
+);
+
+/**
+ * @brief 
+ * Calculates a frequency response from the delay polynomials of a filter.
+ * The transfer function is numerator / denominator, and each polynomial is accompanied 
+ * by the same polynomial with every coefficient multiplied by its delay, for the group delay.
+ * @param fft Transform of length `n_points`
+ * @param polynomials Numerator, delay-weighted numerator, denominator and delay-weighted denominator, 
+ * each of `n_points` elements, aliased modulo `n_points`. Transformed in place.
+ * @param has_feedback Whether the denominator is not 1
+ * @param n_points Number of frequencies
+ * @param response Complex gain at each frequency
+ * @param group_delay Group delay at each frequency. Not calculated if NULL.
+ */
+static void delay_polynomial_response(
+    FftComplex *fft,
+    double complex *polynomials,
+    bool has_feedback,
+    size_t n_points,
+    double complex *response,
+    double *group_delay
+);
+
+/**
+ * @brief 
+ * Finds the symmetry of a set of filter coefficients.
+ * Only exact symmetry is detected, so folding never changes the filter response.
+ * @param coefficients Filter coefficients
+ * @return Symmetry of the coefficients
+ */
+static enum FilterSymmetry fir_symmetry(const VectorReal *coefficients);
+
 double filter_evaluate_digital_filter_real(double input, DigitalFilterReal *filter) {
     assert_not_null(filter);
     assert_not_null(filter->feedforward);
 
     double accumulate = 0.0;
     vector_shift_generic(input, filter->previous_input);
-    accumulate +=
-        vector_dot_generic(
-            filter->feedforward,
-            filter->previous_input
+    if (filter->feedforward_symmetry != ASYMMETRIC) {
+        /**
+         * @brief 
+         * The symmetry was detected when the filter was made, 
+         * which relies on the feedforward terms not being modified or reversed since
+         */
+        const double *coefficients = vector_contiguous_elements_generic(filter->feedforward);
+        assert_not_null(coefficients);
+        accumulate += fir_folded_real(
+            coefficients,
+            vector_length_generic(filter->feedforward),
+            filter->feedforward_symmetry,
+            vector_contiguous_elements_generic(filter->previous_input)
         );
+    }
+    else {
+        accumulate +=
+            vector_dot_generic(
+                filter->feedforward,
+                filter->previous_input
+            );
+    }
     if (filter->feedback != NULL) {
         accumulate += vector_dot_generic(filter->feedback, filter->previous_output);
         vector_shift_generic(accumulate, filter->previous_output);
@@ -58,6 +421,205 @@ double complex filter_evaluate_digital_filter_complex(double complex input, Digi
     return accumulate;
 }
 
+#define FILTER_PROCESS_BLOCK(element_type, fir_block, ...) \
+    assert_not_null(filter); \
+    assert_not_null(filter->feedforward); \
+    assert(length == 0 || (input != NULL && output != NULL)); \
+    \
+    const element_type *coefficients = \
+        vector_contiguous_elements_generic(filter->feedforward); \
+    assert_not_null(coefficients); \
+    size_t n_taps = vector_length_generic(filter->feedforward); \
+    \
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input); \
+    if (block_limit > FILTER_BLOCK_LENGTH) \
+        block_limit = FILTER_BLOCK_LENGTH; \
+    \
+    while (length > 0) { \
+        size_t block_length = length < block_limit ? length : block_limit; \
+        const element_type *history = \
+            vector_shift_block_generic(input, block_length, filter->previous_input); \
+        fir_block(coefficients, n_taps, __VA_ARGS__ history + 1, output, block_length); \
+        \
+        if (filter->feedback != NULL) { \
+            for (size_t i = 0; i < block_length; i++) { \
+                output[i] += vector_dot_generic(filter->feedback, filter->previous_output); \
+                vector_shift_generic(output[i], filter->previous_output); \
+            } \
+        } \
+        \
+        input += block_length; \
+        output += block_length; \
+        length -= block_length; \
+    }
+
+void filter_process_block_real(
+    const double *input, 
+    double *output, 
+    size_t length, 
+    DigitalFilterReal *filter
+) {
+    if (filter->feedforward_symmetry != ASYMMETRIC) {
+        FILTER_PROCESS_BLOCK(double, fir_block_folded_real, filter->feedforward_symmetry,)
+    }
+    else {
+        FILTER_PROCESS_BLOCK(double, fir_block_real,)
+    }
+}
+
+void filter_process_block_complex(
+    const double complex *input, 
+    double complex *output, 
+    size_t length, 
+    DigitalFilterComplex *filter
+) {
+    FILTER_PROCESS_BLOCK(double complex, fir_block_complex,)
+}
+
+static void fir_block_real(
+    const double *restrict coefficients,
+    size_t n_taps,
+    const double *restrict history,
+    double *restrict output,
+    size_t length
+) {
+    assert(length <= FILTER_BLOCK_LENGTH);
+
+    double accumulate[FILTER_BLOCK_LENGTH];
+    for (size_t k = 0; k < length; k++) {
+        accumulate[k] = 0.0;
+    }
+
+    /**
+     * @brief 
+     * Taps are the outer loop so that the inner loop runs across outputs. 
+     * It has no loop-carried dependency and vectorizes without reordering 
+     * the per-output sums.
+     */
+    for (size_t i = 0; i < n_taps; i++) {
+        double coefficient = coefficients[i];
+        const double *tap_input = &history[i];
+        for (size_t k = 0; k < length; k++) {
+            accumulate[k] += coefficient * tap_input[k];
+        }
+    }
+
+    for (size_t k = 0; k < length; k++) {
+        output[k] = accumulate[k];
+    }
+}
+
+static void fir_block_complex(
+    const double complex *restrict coefficients,
+    size_t n_taps,
+    const double complex *restrict history,
+    double complex *restrict output,
+    size_t length
+) {
+    assert(length <= FILTER_BLOCK_LENGTH);
+
+    double accumulate_real[FILTER_BLOCK_LENGTH];
+    double accumulate_imag[FILTER_BLOCK_LENGTH];
+    for (size_t k = 0; k < length; k++) {
+        accumulate_real[k] = 0.0;
+        accumulate_imag[k] = 0.0;
+    }
+
+    for (size_t i = 0; i < n_taps; i++) {
+        double coefficient_real = creal(coefficients[i]);
+        double coefficient_imag = cimag(coefficients[i]);
+        const double complex *tap_input = &history[i];
+        for (size_t k = 0; k < length; k++) {
+            accumulate_real[k] += 
+                coefficient_real * creal(tap_input[k]) - 
+                coefficient_imag * cimag(tap_input[k]);
+            accumulate_imag[k] += 
+                coefficient_real * cimag(tap_input[k]) + 
+                coefficient_imag * creal(tap_input[k]);
+        }
+    }
+
+    for (size_t k = 0; k < length; k++) {
+        output[k] = CMPLX(accumulate_real[k], accumulate_imag[k]);
+    }
+}
+
+static void fir_block_folded_real(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    const double *restrict history,
+    double *restrict output,
+    size_t length
+) {
+    assert(length <= FILTER_BLOCK_LENGTH);
+    assert(symmetry == SYMMETRIC || symmetry == ANTISYMMETRIC);
+
+    double accumulate[FILTER_BLOCK_LENGTH];
+    for (size_t k = 0; k < length; k++) {
+        accumulate[k] = 0.0;
+    }
+
+    size_t n_folded = n_taps / 2;
+    for (size_t i = 0; i < n_folded; i++) {
+        double coefficient = coefficients[i];
+        const double *tap_input = &history[i];
+        const double *mirror_input = &history[n_taps - 1 - i];
+        if (symmetry == SYMMETRIC) {
+            for (size_t k = 0; k < length; k++) {
+                accumulate[k] += coefficient * (tap_input[k] + mirror_input[k]);
+            }
+        }
+        else {
+            for (size_t k = 0; k < length; k++) {
+                accumulate[k] += coefficient * (tap_input[k] - mirror_input[k]);
+            }
+        }
+    }
+
+    /**
+     * @brief 
+     * The center coefficient of an odd-length antisymmetric filter is zero
+     */
+    if ((n_taps & 0x1) == 1 && symmetry == SYMMETRIC) {
+        double coefficient = coefficients[n_folded];
+        const double *tap_input = &history[n_folded];
+        for (size_t k = 0; k < length; k++) {
+            accumulate[k] += coefficient * tap_input[k];
+        }
+    }
+
+    for (size_t k = 0; k < length; k++) {
+        output[k] = accumulate[k];
+    }
+}
+
+static double fir_folded_real(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    const double *restrict window
+) {
+    assert(symmetry == SYMMETRIC || symmetry == ANTISYMMETRIC);
+
+    double accumulate = 0.0;
+    size_t n_folded = n_taps / 2;
+    if (symmetry == SYMMETRIC) {
+        for (size_t i = 0; i < n_folded; i++) {
+            accumulate += coefficients[i] * (window[i] + window[n_taps - 1 - i]);
+        }
+        if ((n_taps & 0x1) == 1) {
+            accumulate += coefficients[n_folded] * window[n_folded];
+        }
+    }
+    else {
+        for (size_t i = 0; i < n_folded; i++) {
+            accumulate += coefficients[i] * (window[i] - window[n_taps - 1 - i]);
+        }
+    }
+    return accumulate;
+}
+
 DigitalFilterComplex *filter_make_digital_filter_complex(
     const VectorComplex *feedforward,
     const VectorComplex *feedback
@@ -72,7 +634,7 @@ DigitalFilterComplex *filter_make_digital_filter_complex(
         goto fail_allocate_feedforward;
     }
     
-    filter->previous_input = vector_complex_new(vector_length_generic(feedforward));
+    filter->previous_input = vector_complex_new_contiguous(vector_length_generic(feedforward));
     if (filter->previous_input == NULL) {
         goto fail_allocate_previous_input;
     }
@@ -85,13 +647,14 @@ DigitalFilterComplex *filter_make_digital_filter_complex(
         }
         
         filter->previous_output = 
-            vector_complex_new(vector_length_generic(feedback));
+            vector_complex_new_contiguous(vector_length_generic(feedback));
         if (filter->previous_output == NULL) {
             goto fail_allocate_previous_output;
         }
     }
     else {
         filter->feedback = NULL;
+        filter->previous_output = NULL;
     }
     
     return filter;
@@ -117,15 +680,18 @@ DigitalFilterReal *filter_make_digital_filter_real(
         return NULL;
     
     assert_valid_vector(feedforward);
-    filter->feedforward = vector_duplicate_generic(feedforward);
-    if (filter->feedforward == NULL) {
+    VectorReal *owned_feedforward = vector_duplicate_generic(feedforward);
+    if (owned_feedforward == NULL) {
         goto fail_allocate_feedforward;
     }
+    filter->feedforward = owned_feedforward;
     
-    filter->previous_input = vector_real_new(vector_length_generic(feedforward));
+    filter->previous_input = vector_real_new_contiguous(vector_length_generic(feedforward));
     if (filter->previous_input == NULL) {
         goto fail_allocate_previous_input;
     }
+    filter->design = NULL;
+    filter->feedforward_symmetry = fir_symmetry(filter->feedforward);
     
     if (feedback != NULL) {
         assert_valid_vector(feedback);
@@ -135,13 +701,14 @@ DigitalFilterReal *filter_make_digital_filter_real(
         }
         
         filter->previous_output = 
-            vector_real_new(vector_length_generic(feedback));
+            vector_real_new_contiguous(vector_length_generic(feedback));
         if (filter->previous_output == NULL) {
             goto fail_allocate_previous_output;
         }
     }
     else {
         filter->feedback = NULL;
+        filter->previous_output = NULL;
     }
     
     return filter;
@@ -151,7 +718,7 @@ DigitalFilterReal *filter_make_digital_filter_real(
     fail_allocate_feedback:
         vector_free_generic(filter->previous_input);
     fail_allocate_previous_input:
-        vector_free_generic(filter->feedforward);
+        vector_free_generic(owned_feedforward);
     fail_allocate_feedforward:
         free(filter);
         return NULL;
@@ -195,7 +762,10 @@ void filter_free_digital_filter_real(DigitalFilterReal *filter) {
     assert_not_null(filter);
     
     assert_not_null(filter->feedforward);
-    vector_free_generic(filter->feedforward);
+    if (filter->design != NULL)
+        design_cache_release(filter->design);
+    else
+        vector_free_generic((VectorReal *) filter->feedforward);
 
     assert_not_null(filter->previous_input);
     vector_free_generic(filter->previous_input);
@@ -208,92 +778,1053 @@ void filter_free_digital_filter_real(DigitalFilterReal *filter) {
     free(filter);
 }
 
-DigitalFilterReal *filter_make_savgol(
-    size_t filter_length, 
-    int derivative, 
-    int polynomial_order
-) {
-    // Window length must be odd
-    assert((filter_length & 0x1) == 1);
-    assert(filter_length > 0);
-    assert(derivative >= 0);
-    assert(derivative <= polynomial_order);
+DecimatorReal *filter_make_decimator(const VectorReal *feedforward, size_t decimation) {
+    assert_valid_vector(feedforward);
+    assert(decimation > 0);
 
-    int center = 0;
-    VectorReal *feedforward = vector_real_new(filter_length);
-    if (feedforward == NULL) {
+    DecimatorReal *filter = malloc(sizeof(DecimatorReal));
+    if (filter == NULL)
         return NULL;
+
+    VectorReal *owned_feedforward = vector_duplicate_generic(feedforward);
+    if (owned_feedforward == NULL) {
+        goto fail_allocate_feedforward;
     }
+    filter->feedforward = owned_feedforward;
 
-    for (size_t i = 1; i <= filter_length; i++) {
-        *vector_real_element(- i, feedforward) = savgol_weight(
-            i, 
-            center, 
-            filter_length, 
-            polynomial_order, 
-            derivative
-        );
+    filter->previous_input = 
+        vector_real_new_contiguous(vector_length_generic(feedforward));
+    if (filter->previous_input == NULL) {
+        goto fail_allocate_previous_input;
     }
 
-    DigitalFilterReal *filter = filter_make_digital_filter_real(feedforward, NULL);
-    vector_real_free(feedforward);
+    filter->feedforward_symmetry = fir_symmetry(filter->feedforward);
+    filter->decimation = decimation;
+    filter->phase = 0;
     return filter;
+
+    fail_allocate_previous_input:
+        vector_free_generic(owned_feedforward);
+    fail_allocate_feedforward:
+        free(filter);
+        return NULL;
 }
 
-DigitalFilterComplex *filter_make_ewma(double alpha) {
-    assert(alpha >= 0.0);
-    assert(alpha <= 1.0);
+size_t filter_process_block_decimator(
+    const double *input, 
+    double *output, 
+    size_t length, 
+    DecimatorReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
 
-    VectorComplex *feedforward = vector_complex_new(1);
-    if (feedforward == NULL)
-        goto feedforward_allocation_failed;
-    *vector_complex_element(0, feedforward) = alpha;
+    const double *coefficients = vector_contiguous_elements_generic(filter->feedforward);
+    assert_not_null(coefficients);
+    size_t n_taps = vector_length_generic(filter->feedforward);
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input);
 
-    VectorComplex *feedback = vector_complex_new(1);
-    if (feedback == NULL)
-        goto feedback_allocation_failed;
-    *vector_complex_element(0, feedback) = 1 - alpha;
+    size_t n_outputs = 0;
+    while (length > 0) {
+        size_t block_length = length < block_limit ? length : block_limit;
+        const double *history = 
+            vector_shift_block_generic(input, block_length, filter->previous_input);
 
-    DigitalFilterComplex *filter = 
-        filter_make_digital_filter_complex(feedforward, feedback);
+        /**
+         * @brief 
+         * The window after shifting in input `i` of the block starts at `history[i + 1]`. 
+         * Only the windows that complete a decimation period are evaluated.
+         */
+        for (
+            size_t i = filter->decimation - 1 - filter->phase; 
+            i < block_length; 
+            i += filter->decimation
+        ) {
+            const double *window = &history[i + 1];
+            if (filter->feedforward_symmetry != ASYMMETRIC) {
+                output[n_outputs++] = fir_folded_real(
+                    coefficients, n_taps, filter->feedforward_symmetry, window
+                );
+                continue;
+            }
 
-    vector_complex_free(feedforward);
-    vector_complex_free(feedback);
-    
-    return filter;
+            double sum = 0;
+            for (size_t j = 0; j < n_taps; j++) {
+                sum += coefficients[j] * window[j];
+            }
+            output[n_outputs++] = sum;
+        }
+        filter->phase = (filter->phase + block_length) % filter->decimation;
 
-    feedback_allocation_failed:
-        vector_complex_free(feedforward);
-    feedforward_allocation_failed:
-        return NULL;
+        input += block_length;
+        length -= block_length;
+    }
+    return n_outputs;
 }
 
-DigitalFilterComplex *filter_make_first_order_iir(double cutoff_frequency) {
-    assert(cutoff_frequency < 0.5);
-    assert(cutoff_frequency >= 0);
-    double angular_frequency = ordinary_frequency_to_angular(cutoff_frequency);
-    return filter_make_ewma(
-        cos(angular_frequency) -
-        1 +
-        sqrt(
-            pow(cos(angular_frequency), 2) - 4 * cos(angular_frequency) + 3
-        )
-    );
+void filter_reset_decimator(DecimatorReal *filter) {
+    assert_not_null(filter);
+
+    vector_reset_generic(filter->previous_input);
+    filter->phase = 0;
 }
 
-DigitalFilterReal *filter_make_sinc(
-    double cutoff_frequency, 
-    size_t length, 
-    enum FilterType filter_type,
-    WindowFunction window
-) {
-    assert(cutoff_frequency >= 0);
-    assert(filter_type == LOW_PASS || filter_type == HIGH_PASS);
-    assert((length & 0x1) == 1);
+void filter_free_decimator(DecimatorReal *filter) {
+    assert_not_null(filter);
+
+    assert_not_null(filter->feedforward);
+    vector_free_generic((VectorReal *) filter->feedforward);
+
+    assert_not_null(filter->previous_input);
+    vector_free_generic(filter->previous_input);
+
+    free(filter);
+}
+
+DigitalFilterBankReal *filter_make_digital_filter_bank_real(
+    const VectorReal *feedforward, 
+    size_t n_channels
+) {
+    assert_valid_vector(feedforward);
+    assert(n_channels > 0);
+
+    DigitalFilterBankReal *filter = malloc(sizeof(DigitalFilterBankReal));
+    if (filter == NULL)
+        return NULL;
+
+    VectorReal *owned_feedforward = vector_duplicate_generic(feedforward);
+    if (owned_feedforward == NULL) {
+        goto fail_allocate_feedforward;
+    }
+    filter->feedforward = owned_feedforward;
+
+    /**
+     * @brief 
+     * The window slides forward through the delay line and is moved back 
+     * once it reaches the end, so each frame is copied once more on average
+     */
+    size_t n_taps = vector_length_generic(feedforward);
+    filter->capacity = 2 * n_taps;
+    filter->previous_input = calloc(filter->capacity * n_channels, sizeof(double));
+    if (filter->previous_input == NULL) {
+        goto fail_allocate_previous_input;
+    }
+
+    filter->feedforward_symmetry = fir_symmetry(filter->feedforward);
+    filter->n_channels = n_channels;
+    filter->oldest_frame = 0;
+    return filter;
+
+    fail_allocate_previous_input:
+        vector_free_generic(owned_feedforward);
+    fail_allocate_feedforward:
+        free(filter);
+        return NULL;
+}
+
+void filter_evaluate_digital_filter_bank_real(
+    const double *input, 
+    double *output, 
+    DigitalFilterBankReal *filter
+) {
+    assert_not_null(filter);
+    assert_not_null(input);
+    assert_not_null(output);
+
+    const double *coefficients = vector_contiguous_elements_generic(filter->feedforward);
+    assert_not_null(coefficients);
+    size_t n_taps = vector_length_generic(filter->feedforward);
+    size_t n_channels = filter->n_channels;
+
+    if (filter->oldest_frame + n_taps == filter->capacity) {
+        memmove(
+            filter->previous_input, 
+            &filter->previous_input[(filter->oldest_frame + 1) * n_channels], 
+            (n_taps - 1) * n_channels * sizeof(double)
+        );
+        filter->oldest_frame = 0;
+    }
+    else {
+        filter->oldest_frame++;
+    }
+    const double *window = &filter->previous_input[filter->oldest_frame * n_channels];
+    memcpy(
+        &filter->previous_input[(filter->oldest_frame + n_taps - 1) * n_channels], 
+        input, 
+        n_channels * sizeof(double)
+    );
+
+    fir_bank_real(
+        coefficients, 
+        n_taps, 
+        filter->feedforward_symmetry, 
+        n_channels, 
+        window, 
+        output
+    );
+}
+
+void filter_process_block_digital_filter_bank_real(
+    const double *input, 
+    double *output, 
+    size_t n_frames, 
+    DigitalFilterBankReal *filter
+) {
+    assert_not_null(filter);
+    assert(n_frames == 0 || (input != NULL && output != NULL));
+
+    for (size_t i = 0; i < n_frames; i++) {
+        filter_evaluate_digital_filter_bank_real(
+            &input[i * filter->n_channels], 
+            &output[i * filter->n_channels], 
+            filter
+        );
+    }
+}
+
+void filter_reset_digital_filter_bank_real(DigitalFilterBankReal *filter) {
+    assert_not_null(filter);
+
+    for (size_t i = 0; i < filter->capacity * filter->n_channels; i++) {
+        filter->previous_input[i] = 0.0;
+    }
+    filter->oldest_frame = 0;
+}
+
+void filter_free_digital_filter_bank_real(DigitalFilterBankReal *filter) {
+    assert_not_null(filter);
+
+    assert_not_null(filter->feedforward);
+    vector_free_generic((VectorReal *) filter->feedforward);
+
+    assert_not_null(filter->previous_input);
+    free(filter->previous_input);
+
+    free(filter);
+}
+
+static void fir_bank_real(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    size_t n_channels,
+    const double *restrict window,
+    double *restrict output
+) {
+    for (size_t k = 0; k < n_channels; k++) {
+        output[k] = 0.0;
+    }
+
+    /**
+     * @brief 
+     * Taps are the outer loop so that the inner loop runs across channels, 
+     * accumulating each channel in the same order as a single-channel filter
+     */
+    if (symmetry == ASYMMETRIC) {
+        for (size_t i = 0; i < n_taps; i++) {
+            double coefficient = coefficients[i];
+            const double *tap_input = &window[i * n_channels];
+            for (size_t k = 0; k < n_channels; k++) {
+                output[k] += coefficient * tap_input[k];
+            }
+        }
+        return;
+    }
+
+    size_t n_folded = n_taps / 2;
+    for (size_t i = 0; i < n_folded; i++) {
+        double coefficient = coefficients[i];
+        const double *tap_input = &window[i * n_channels];
+        const double *mirror_input = &window[(n_taps - 1 - i) * n_channels];
+        if (symmetry == SYMMETRIC) {
+            for (size_t k = 0; k < n_channels; k++) {
+                output[k] += coefficient * (tap_input[k] + mirror_input[k]);
+            }
+        }
+        else {
+            for (size_t k = 0; k < n_channels; k++) {
+                output[k] += coefficient * (tap_input[k] - mirror_input[k]);
+            }
+        }
+    }
+    if ((n_taps & 0x1) == 1 && symmetry == SYMMETRIC) {
+        double coefficient = coefficients[n_folded];
+        const double *tap_input = &window[n_folded * n_channels];
+        for (size_t k = 0; k < n_channels; k++) {
+            output[k] += coefficient * tap_input[k];
+        }
+    }
+}
+
+DigitalFilterMixed *filter_make_digital_filter_mixed(
+    const VectorReal *feedforward,
+    const VectorReal *feedback
+) {
+    DigitalFilterMixed *filter = malloc(sizeof(DigitalFilterMixed));
+    if (filter == NULL)
+        return NULL;
+    
+    assert_valid_vector(feedforward);
+    VectorReal *owned_feedforward = vector_duplicate_generic(feedforward);
+    if (owned_feedforward == NULL) {
+        goto fail_allocate_feedforward;
+    }
+    filter->feedforward = owned_feedforward;
+    filter->design = NULL;
+    
+    filter->previous_input = vector_complex_new_contiguous(vector_length_generic(feedforward));
+    if (filter->previous_input == NULL) {
+        goto fail_allocate_previous_input;
+    }
+    filter->feedforward_symmetry = fir_symmetry(filter->feedforward);
+    
+    if (feedback != NULL) {
+        assert_valid_vector(feedback);
+        filter->feedback = vector_duplicate_generic(feedback);
+        if (filter->feedback == NULL) {
+            goto fail_allocate_feedback;
+        }
+        
+        filter->previous_output = 
+            vector_complex_new_contiguous(vector_length_generic(feedback));
+        if (filter->previous_output == NULL) {
+            goto fail_allocate_previous_output;
+        }
+    }
+    else {
+        filter->feedback = NULL;
+        filter->previous_output = NULL;
+    }
+    
+    return filter;
+    
+    fail_allocate_previous_output:
+        vector_free_generic(filter->feedback);
+    fail_allocate_feedback:
+        vector_free_generic(filter->previous_input);
+    fail_allocate_previous_input:
+        vector_free_generic(owned_feedforward);
+    fail_allocate_feedforward:
+        free(filter);
+        return NULL;
+}
+
+DigitalFilterMixed *filter_make_digital_filter_mixed_from_real(const DigitalFilterReal *filter) {
+    assert_not_null(filter);
+
+    if (filter->design == NULL)
+        return filter_make_digital_filter_mixed(filter->feedforward, filter->feedback);
+
+    /**
+     * @brief 
+     * Cached designs are FIR, and are shared by taking another reference to them
+     */
+    assert(filter->feedback == NULL);
+    DigitalFilterMixed *mixed = malloc(sizeof(DigitalFilterMixed));
+    if (mixed == NULL)
+        return NULL;
+
+    mixed->previous_input = vector_complex_new_contiguous(vector_length_generic(filter->feedforward));
+    if (mixed->previous_input == NULL) {
+        free(mixed);
+        return NULL;
+    }
+
+    design_cache_retain(filter->design);
+    mixed->feedforward = filter->feedforward;
+    mixed->design = filter->design;
+    mixed->feedforward_symmetry = filter->feedforward_symmetry;
+    mixed->feedback = NULL;
+    mixed->previous_output = NULL;
+    return mixed;
+}
+
+double complex filter_evaluate_digital_filter_mixed(double complex input, DigitalFilterMixed *filter) {
+    assert_not_null(filter);
+    assert_not_null(filter->feedforward);
+
+    vector_shift_generic(input, filter->previous_input);
+    const double *coefficients = vector_contiguous_elements_generic(filter->feedforward);
+    assert_not_null(coefficients);
+    double complex accumulate = fir_mixed(
+        coefficients,
+        vector_length_generic(filter->feedforward),
+        filter->feedforward_symmetry,
+        vector_contiguous_elements_generic(filter->previous_input)
+    );
+    if (filter->feedback != NULL) {
+        const double *feedback = vector_contiguous_elements_generic(filter->feedback);
+        assert_not_null(feedback);
+        accumulate += fir_mixed(
+            feedback,
+            vector_length_generic(filter->feedback),
+            ASYMMETRIC,
+            vector_contiguous_elements_generic(filter->previous_output)
+        );
+        vector_shift_generic(accumulate, filter->previous_output);
+    }
+    return accumulate;
+}
+
+void filter_process_block_mixed(
+    const double complex *input, 
+    double complex *output, 
+    size_t length, 
+    DigitalFilterMixed *filter
+) {
+    assert_not_null(filter);
+    assert_not_null(filter->feedforward);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    const double *coefficients = vector_contiguous_elements_generic(filter->feedforward);
+    assert_not_null(coefficients);
+    size_t n_taps = vector_length_generic(filter->feedforward);
+
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input);
+    if (block_limit > FILTER_BLOCK_LENGTH)
+        block_limit = FILTER_BLOCK_LENGTH;
+
+    while (length > 0) {
+        size_t block_length = length < block_limit ? length : block_limit;
+        const double complex *history = 
+            vector_shift_block_generic(input, block_length, filter->previous_input);
+        fir_block_mixed(
+            coefficients, 
+            n_taps, 
+            filter->feedforward_symmetry, 
+            history + 1, 
+            output, 
+            block_length
+        );
+
+        if (filter->feedback != NULL) {
+            const double *feedback = vector_contiguous_elements_generic(filter->feedback);
+            assert_not_null(feedback);
+            size_t n_feedback = vector_length_generic(filter->feedback);
+            for (size_t i = 0; i < block_length; i++) {
+                output[i] += fir_mixed(
+                    feedback, 
+                    n_feedback, 
+                    ASYMMETRIC, 
+                    vector_contiguous_elements_generic(filter->previous_output)
+                );
+                vector_shift_generic(output[i], filter->previous_output);
+            }
+        }
+
+        input += block_length;
+        output += block_length;
+        length -= block_length;
+    }
+}
+
+void filter_reset_digital_filter_mixed(DigitalFilterMixed *filter) {
+    assert_not_null(filter);
+    
+    vector_reset_generic(filter->previous_input);
+    if (filter->previous_output)
+        vector_reset_generic(filter->previous_output);
+}
+
+void filter_free_digital_filter_mixed(DigitalFilterMixed *filter) {
+    assert_not_null(filter);
+    
+    assert_not_null(filter->feedforward);
+    if (filter->design != NULL)
+        design_cache_release(filter->design);
+    else
+        vector_free_generic((VectorReal *) filter->feedforward);
+
+    assert_not_null(filter->previous_input);
+    vector_free_generic(filter->previous_input);
+
+    if (filter->feedback != NULL) {
+        vector_free_generic(filter->feedback);
+        assert_not_null(filter->previous_output);
+        vector_free_generic(filter->previous_output);
+    }
+    free(filter);
+}
+
+static double complex fir_mixed(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    const double complex *restrict window
+) {
+    /**
+     * @brief 
+     * Complex values are laid out as (real, imaginary) pairs
+     */
+    const double *samples = (const double *) window;
+    double accumulate_real = 0.0;
+    double accumulate_imag = 0.0;
+
+    if (symmetry == ASYMMETRIC) {
+        for (size_t i = 0; i < n_taps; i++) {
+            accumulate_real += coefficients[i] * samples[2 * i];
+            accumulate_imag += coefficients[i] * samples[2 * i + 1];
+        }
+        return CMPLX(accumulate_real, accumulate_imag);
+    }
+
+    size_t n_folded = n_taps / 2;
+    double sign = symmetry == SYMMETRIC ? 1.0 : -1.0;
+    for (size_t i = 0; i < n_folded; i++) {
+        size_t mirror = n_taps - 1 - i;
+        accumulate_real += coefficients[i] * (samples[2 * i] + sign * samples[2 * mirror]);
+        accumulate_imag += coefficients[i] * (samples[2 * i + 1] + sign * samples[2 * mirror + 1]);
+    }
+    if ((n_taps & 0x1) == 1 && symmetry == SYMMETRIC) {
+        accumulate_real += coefficients[n_folded] * samples[2 * n_folded];
+        accumulate_imag += coefficients[n_folded] * samples[2 * n_folded + 1];
+    }
+    return CMPLX(accumulate_real, accumulate_imag);
+}
+
+static void fir_block_mixed(
+    const double *restrict coefficients,
+    size_t n_taps,
+    enum FilterSymmetry symmetry,
+    const double complex *restrict history,
+    double complex *restrict output,
+    size_t length
+) {
+    assert(length <= FILTER_BLOCK_LENGTH);
+
+    const double *samples = (const double *) history;
+    double accumulate_real[FILTER_BLOCK_LENGTH];
+    double accumulate_imag[FILTER_BLOCK_LENGTH];
+    for (size_t k = 0; k < length; k++) {
+        accumulate_real[k] = 0.0;
+        accumulate_imag[k] = 0.0;
+    }
+
+    if (symmetry == ASYMMETRIC) {
+        for (size_t i = 0; i < n_taps; i++) {
+            double coefficient = coefficients[i];
+            const double *tap_input = &samples[2 * i];
+            for (size_t k = 0; k < length; k++) {
+                accumulate_real[k] += coefficient * tap_input[2 * k];
+                accumulate_imag[k] += coefficient * tap_input[2 * k + 1];
+            }
+        }
+    }
+    else {
+        size_t n_folded = n_taps / 2;
+        double sign = symmetry == SYMMETRIC ? 1.0 : -1.0;
+        for (size_t i = 0; i < n_folded; i++) {
+            double coefficient = coefficients[i];
+            const double *tap_input = &samples[2 * i];
+            const double *mirror_input = &samples[2 * (n_taps - 1 - i)];
+            for (size_t k = 0; k < length; k++) {
+                accumulate_real[k] += 
+                    coefficient * (tap_input[2 * k] + sign * mirror_input[2 * k]);
+                accumulate_imag[k] += 
+                    coefficient * (tap_input[2 * k + 1] + sign * mirror_input[2 * k + 1]);
+            }
+        }
+        if ((n_taps & 0x1) == 1 && symmetry == SYMMETRIC) {
+            double coefficient = coefficients[n_folded];
+            const double *tap_input = &samples[2 * n_folded];
+            for (size_t k = 0; k < length; k++) {
+                accumulate_real[k] += coefficient * tap_input[2 * k];
+                accumulate_imag[k] += coefficient * tap_input[2 * k + 1];
+            }
+        }
+    }
+
+    for (size_t k = 0; k < length; k++) {
+        output[k] = CMPLX(accumulate_real[k], accumulate_imag[k]);
+    }
+}
+
+FrequencyResponsePlan *filter_make_frequency_response_plan(size_t n_points) {
+    assert(n_points > 0 && (n_points & (n_points - 1)) == 0);
+
+    FrequencyResponsePlan *plan = malloc(sizeof(FrequencyResponsePlan));
+    if (plan == NULL)
+        return NULL;
+
+    plan->fft = fft_make_fft_complex(n_points);
+    if (plan->fft == NULL)
+        goto fail_allocate_fft;
+
+    plan->polynomials = malloc(4 * n_points * sizeof(double complex));
+    if (plan->polynomials == NULL)
+        goto fail_allocate_polynomials;
+
+    plan->n_points = n_points;
+    return plan;
+
+    fail_allocate_polynomials:
+        fft_free_fft_complex(plan->fft);
+    fail_allocate_fft:
+        free(plan);
+        return NULL;
+}
+
+void filter_free_frequency_response_plan(FrequencyResponsePlan *plan) {
+    assert_not_null(plan);
+
+    fft_free_fft_complex(plan->fft);
+    free(plan->polynomials);
+    free(plan);
+}
+
+#define FILTER_FREQUENCY_RESPONSE(element_type) \
+    assert_not_null(filter); \
+    assert_not_null(filter->feedforward); \
+    assert_not_null(plan); \
+    assert_not_null(response); \
+    \
+    size_t n_points = plan->n_points; \
+    bool has_feedback = filter->feedback != NULL; \
+    double complex *numerator = plan->polynomials; \
+    double complex *weighted_numerator = numerator + n_points; \
+    double complex *denominator = weighted_numerator + n_points; \
+    double complex *weighted_denominator = denominator + n_points; \
+    \
+    /** \
+     * @brief \
+     * The denominators are only cleared for filters that use them \
+     */ \
+    for (size_t k = 0; k < n_points; k++) { \
+        numerator[k] = 0.0; \
+        weighted_numerator[k] = 0.0; \
+    } \
+    if (has_feedback) { \
+        for (size_t k = 0; k < n_points; k++) { \
+            denominator[k] = 0.0; \
+            weighted_denominator[k] = 0.0; \
+        } \
+    } \
+    \
+    /** \
+     * @brief \
+     * Feedforward element `i` is applied to the input delayed by `n_feedforward - 1 - i`. \
+     * Feedback element `j` is added from the output delayed by `n_feedback - j`, \
+     * so it is subtracted in the denominator. \
+     * Delays beyond the transform length wrap around, which samples the response exactly. \
+     */ \
+    const element_type *feedforward = vector_contiguous_elements_generic(filter->feedforward); \
+    assert_not_null(feedforward); \
+    size_t n_feedforward = vector_length_generic(filter->feedforward); \
+    for (size_t i = 0; i < n_feedforward; i++) { \
+        size_t delay = n_feedforward - 1 - i; \
+        numerator[delay % n_points] += feedforward[i]; \
+        weighted_numerator[delay % n_points] += (double) delay * feedforward[i]; \
+    } \
+    if (has_feedback) { \
+        const element_type *feedback = vector_contiguous_elements_generic(filter->feedback); \
+        assert_not_null(feedback); \
+        size_t n_feedback = vector_length_generic(filter->feedback); \
+        denominator[0] = 1.0; \
+        for (size_t j = 0; j < n_feedback; j++) { \
+            size_t delay = n_feedback - j; \
+            denominator[delay % n_points] -= feedback[j]; \
+            weighted_denominator[delay % n_points] -= (double) delay * feedback[j]; \
+        } \
+    } \
+    \
+    delay_polynomial_response( \
+        plan->fft, plan->polynomials, has_feedback, n_points, response, group_delay \
+    );
+
+void filter_frequency_response_real(
+    const DigitalFilterReal *filter, 
+    FrequencyResponsePlan *plan, 
+    double complex *response, 
+    double *group_delay
+) {
+    FILTER_FREQUENCY_RESPONSE(double)
+}
+
+void filter_frequency_response_complex(
+    const DigitalFilterComplex *filter, 
+    FrequencyResponsePlan *plan, 
+    double complex *response, 
+    double *group_delay
+) {
+    FILTER_FREQUENCY_RESPONSE(double complex)
+}
+
+static void delay_polynomial_response(
+    FftComplex *fft,
+    double complex *polynomials,
+    bool has_feedback,
+    size_t n_points,
+    double complex *response,
+    double *group_delay
+) {
+    double complex *numerator = polynomials;
+    double complex *weighted_numerator = numerator + n_points;
+    double complex *denominator = weighted_numerator + n_points;
+    double complex *weighted_denominator = denominator + n_points;
+
+    fft_fft_array(numerator, fft);
+    if (group_delay != NULL)
+        fft_fft_array(weighted_numerator, fft);
+    if (has_feedback) {
+        fft_fft_array(denominator, fft);
+        if (group_delay != NULL)
+            fft_fft_array(weighted_denominator, fft);
+    }
+
+    /**
+     * @brief 
+     * The group delay of a polynomial X is Re(X_w / X), 
+     * where X_w has each coefficient multiplied by its delay
+     */
+    for (size_t k = 0; k < n_points; k++) {
+        response[k] = has_feedback ? numerator[k] / denominator[k] : numerator[k];
+        if (group_delay != NULL) {
+            group_delay[k] = creal(weighted_numerator[k] / numerator[k]);
+            if (has_feedback)
+                group_delay[k] -= creal(weighted_denominator[k] / denominator[k]);
+        }
+    }
+}
+
+DigitalFilterReal *filter_make_savgol(
+    size_t filter_length, 
+    int derivative, 
+    int polynomial_order
+) {
+    // Window length must be odd
+    assert((filter_length & 0x1) == 1);
+    assert(filter_length > 0);
+    assert(derivative >= 0);
+    assert(derivative <= polynomial_order);
+
+    FilterDesignKey key = {
+        .design = FILTER_DESIGN_SAVGOL,
+        .length = filter_length,
+        .cutoff_frequency = 0.0,
+        .derivative = derivative,
+        .polynomial_order = polynomial_order,
+        .filter_type = LOW_PASS,
+        .window = NULL
+    };
+    FilterDesignCacheEntry *design = design_cache_acquire(&key);
+    if (design == NULL) {
+        return NULL;
+    }
+    return filter_make_shared_fir_real(design);
+}
+
+DigitalFilterComplex *filter_make_ewma(double alpha) {
+    assert(alpha >= 0.0);
+    assert(alpha <= 1.0);
+
+    VectorComplex *feedforward = vector_complex_new(1);
+    if (feedforward == NULL)
+        goto feedforward_allocation_failed;
+    *vector_complex_element(0, feedforward) = alpha;
+
+    VectorComplex *feedback = vector_complex_new(1);
+    if (feedback == NULL)
+        goto feedback_allocation_failed;
+    *vector_complex_element(0, feedback) = 1 - alpha;
+
+    DigitalFilterComplex *filter = 
+        filter_make_digital_filter_complex(feedforward, feedback);
+
+    vector_complex_free(feedforward);
+    vector_complex_free(feedback);
+    
+    return filter;
+
+    feedback_allocation_failed:
+        vector_complex_free(feedforward);
+    feedforward_allocation_failed:
+        return NULL;
+}
+
+DigitalFilterComplex *filter_make_first_order_iir(double cutoff_frequency) {
+    return filter_make_ewma(ewma_alpha_from_cutoff(cutoff_frequency));
+}
+
+DigitalFilterReal *filter_make_sinc(
+    double cutoff_frequency, 
+    size_t length, 
+    enum FilterType filter_type,
+    WindowFunction window
+) {
+    assert(cutoff_frequency >= 0);
+    assert(filter_type == LOW_PASS || filter_type == HIGH_PASS);
+    assert((length & 0x1) == 1);
 
     if (window == NULL)
         window = window_rectangular;
 
+    FilterDesignKey key = {
+        .design = FILTER_DESIGN_SINC,
+        .length = length,
+        .cutoff_frequency = cutoff_frequency,
+        .derivative = 0,
+        .polynomial_order = 0,
+        .filter_type = filter_type,
+        .window = window
+    };
+    FilterDesignCacheEntry *design = design_cache_acquire(&key);
+    if (design == NULL) {
+        return NULL;
+    }
+    return filter_make_shared_fir_real(design);
+}
+
+static DigitalFilterReal *filter_make_shared_fir_real(FilterDesignCacheEntry *design) {
+    assert_not_null(design);
+    assert_valid_vector(design->coefficients);
+
+    DigitalFilterReal *filter = malloc(sizeof(DigitalFilterReal));
+    if (filter == NULL)
+        goto fail_allocate_filter;
+
+    filter->previous_input = 
+        vector_real_new_contiguous(vector_length_generic(design->coefficients));
+    if (filter->previous_input == NULL)
+        goto fail_allocate_previous_input;
+
+    filter->feedforward = design->coefficients;
+    filter->design = design;
+    filter->feedforward_symmetry = fir_symmetry(filter->feedforward);
+    filter->feedback = NULL;
+    filter->previous_output = NULL;
+    return filter;
+
+    fail_allocate_previous_input:
+        free(filter);
+    fail_allocate_filter:
+        design_cache_release(design);
+        return NULL;
+}
+
+static FilterDesignCacheEntry *design_cache_acquire(const FilterDesignKey *key) {
+    size_t bucket = design_key_bucket(key);
+    if (!design_cache_lock())
+        return NULL;
+    FilterDesignCacheEntry *entry = design_cache_find(key, bucket);
+    if (entry != NULL)
+        entry->n_references++;
+    design_cache_unlock();
+    if (entry != NULL)
+        return entry;
+
+    /**
+     * @brief 
+     * The cache is not locked while designing, so different designs are computed concurrently. 
+     * Concurrent requests for the same new design may each compute it, 
+     * in which case only the first one added is kept.
+     */
+    FilterDesignCacheEntry *designed = malloc(sizeof(FilterDesignCacheEntry));
+    if (designed == NULL)
+        return NULL;
+
+    VectorReal *coefficients = key->design == FILTER_DESIGN_SINC ? 
+        design_sinc(key->cutoff_frequency, key->length, key->filter_type, key->window) : 
+        design_savgol(key->length, key->derivative, key->polynomial_order);
+    if (coefficients == NULL) {
+        free(designed);
+        return NULL;
+    }
+
+    /**
+     * @brief 
+     * Duplicates are stored in logical order, 
+     * so the shared coefficients are contiguous like those of any other filter
+     */
+    designed->coefficients = vector_real_duplicate(coefficients);
+    vector_real_free(coefficients);
+    if (designed->coefficients == NULL) {
+        free(designed);
+        return NULL;
+    }
+    designed->key = *key;
+    designed->n_references = 0;
+
+    if (!design_cache_lock()) {
+        vector_real_free(designed->coefficients);
+        free(designed);
+        return NULL;
+    }
+    entry = design_cache_find(key, bucket);
+    if (entry == NULL) {
+        designed->next = design_cache[bucket];
+        design_cache[bucket] = designed;
+        entry = designed;
+        designed = NULL;
+    }
+    entry->n_references++;
+    design_cache_unlock();
+
+    if (designed != NULL) {
+        vector_real_free(designed->coefficients);
+        free(designed);
+    }
+    return entry;
+}
+
+static void design_cache_retain(FilterDesignCacheEntry *entry) {
+    assert_not_null(entry);
+
+    /**
+     * @brief 
+     * The caller holds a reference, so the lock was initialized and the entry cannot be freed meanwhile
+     */
+    bool is_locked = design_cache_lock();
+    assert(is_locked);
+    (void) is_locked;
+    entry->n_references++;
+    design_cache_unlock();
+}
+
+static void design_cache_release(FilterDesignCacheEntry *entry) {
+    assert_not_null(entry);
+
+    /**
+     * @brief 
+     * The entry was acquired, so the lock was initialized. 
+     * Skipping the decrement would leak the entry, so failing to lock is fatal.
+     */
+    size_t bucket = design_key_bucket(&entry->key);
+    bool is_locked = design_cache_lock();
+    assert(is_locked);
+    (void) is_locked;
+
+    bool is_unused = --entry->n_references == 0;
+    if (is_unused) {
+        FilterDesignCacheEntry **link = &design_cache[bucket];
+        while (*link != entry) {
+            link = &(*link)->next;
+        }
+        *link = entry->next;
+    }
+    design_cache_unlock();
+
+    if (is_unused) {
+        vector_real_free(entry->coefficients);
+        free(entry);
+    }
+}
+
+static FilterDesignCacheEntry *design_cache_find(const FilterDesignKey *key, size_t bucket) {
+    for (
+        FilterDesignCacheEntry *entry = design_cache[bucket]; 
+        entry != NULL; 
+        entry = entry->next
+    ) {
+        if (design_key_equal(&entry->key, key))
+            return entry;
+    }
+    return NULL;
+}
+
+static bool design_cache_lock(void) {
+#ifndef __STDC_NO_THREADS__
+    call_once(&design_cache_once, design_cache_initialize);
+    return design_cache_mutex_initialized && mtx_lock(&design_cache_mutex) == thrd_success;
+#else
+    return true;
+#endif
+}
+
+static void design_cache_unlock(void) {
+#ifndef __STDC_NO_THREADS__
+    mtx_unlock(&design_cache_mutex);
+#endif
+}
+
+#ifndef __STDC_NO_THREADS__
+static void design_cache_initialize(void) {
+    design_cache_mutex_initialized = mtx_init(&design_cache_mutex, mtx_plain) == thrd_success;
+}
+#endif
+
+static size_t design_key_bucket(const FilterDesignKey *key) {
+    /**
+     * @brief 
+     * Adding zero turns a negative zero cutoff into a positive one, 
+     * so equal keys have equal bits
+     */
+    double cutoff_frequency = key->cutoff_frequency + 0.0;
+    uint64_t cutoff_bits;
+    memcpy(&cutoff_bits, &cutoff_frequency, sizeof(cutoff_bits));
+
+    /**
+     * @brief 
+     * FNV-1a hash of the key fields
+     */
+    const uint64_t fields[] = {
+        (uint64_t) key->design, 
+        (uint64_t) key->length, 
+        cutoff_bits, 
+        (uint64_t) key->derivative, 
+        (uint64_t) key->polynomial_order, 
+        (uint64_t) key->filter_type, 
+        (uint64_t) (uintptr_t) key->window
+    };
+    uint64_t hash = 14695981039346656037u;
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        hash ^= fields[i];
+        hash *= 1099511628211u;
+    }
+    hash ^= hash >> 32;
+    return (size_t) (hash % DESIGN_CACHE_N_BUCKETS);
+}
+
+static bool design_key_equal(const FilterDesignKey *a, const FilterDesignKey *b) {
+    return 
+        a->design == b->design && 
+        a->length == b->length && 
+        a->cutoff_frequency == b->cutoff_frequency && 
+        a->derivative == b->derivative && 
+        a->polynomial_order == b->polynomial_order && 
+        a->filter_type == b->filter_type && 
+        a->window == b->window;
+}
+
+static VectorReal *design_savgol(
+    size_t filter_length, 
+    int derivative, 
+    int polynomial_order
+) {
+    int center = 0;
+    double *weights = malloc(sizeof(double) * filter_length * (derivative + 1));
+    if (weights == NULL) {
+        return NULL;
+    }
+    if (!savgol_weights(center, filter_length, polynomial_order, derivative, weights)) {
+        free(weights);
+        return NULL;
+    }
+
+    VectorReal *feedforward = vector_real_new(filter_length);
+    if (feedforward == NULL) {
+        free(weights);
+        return NULL;
+    }
+
+    /**
+     * @brief 
+     * Filter coefficients are applied oldest input first, 
+     * which is the canonical order of the weights
+     */
+    const double *derivative_weights = &weights[derivative * filter_length];
+    for (size_t i = 0; i < filter_length; i++) {
+        *vector_real_element(i, feedforward) = derivative_weights[i];
+    }
+    free(weights);
+    return feedforward;
+}
+
+static VectorReal *design_sinc(
+    double cutoff_frequency, 
+    size_t length, 
+    enum FilterType filter_type,
+    WindowFunction window
+) {
     VectorReal *filter_coefficients = vector_real_new(length);
     if (filter_coefficients == NULL) {
         return NULL;
@@ -318,12 +1849,29 @@ DigitalFilterReal *filter_make_sinc(
             dc_corrected_coefficient : 
             dirac_delta(i - length / 2) - dc_corrected_coefficient;
     }
-    DigitalFilterReal *filter = 
-        filter_make_digital_filter_real(filter_coefficients, NULL);
-    
-    vector_real_free(filter_coefficients);
+    return filter_coefficients;
+}
 
-    return filter;
+static enum FilterSymmetry fir_symmetry(const VectorReal *coefficients) {
+    const double *elements = vector_contiguous_elements_generic(coefficients);
+    assert_not_null(elements);
+    size_t n_taps = vector_length_generic(coefficients);
+
+    bool is_symmetric = true;
+    bool is_antisymmetric = true;
+    for (size_t i = 0; i < (n_taps + 1) / 2; i++) {
+        double coefficient = elements[i];
+        double mirror_coefficient = elements[n_taps - 1 - i];
+        is_symmetric = is_symmetric && coefficient == mirror_coefficient;
+        is_antisymmetric = is_antisymmetric && coefficient == -mirror_coefficient;
+    }
+
+    if (is_symmetric)
+        return SYMMETRIC;
+    else if (is_antisymmetric)
+        return ANTISYMMETRIC;
+    else
+        return ASYMMETRIC;
 }
 
 double sinc(double x) {
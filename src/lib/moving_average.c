@@ -1,6 +1,73 @@
+#include <math.h>
+
 #include "moving_average.h"
 #include "assertions.h"
 
+/**
+ * @brief 
+ * Maximum number of outputs computed together by `moving_average_cascade_real_process_block`.
+ * Sized so that the stage buffer stays resident in L1 cache.
+ */
+#define MOVING_AVERAGE_CASCADE_BLOCK_LENGTH 256
+
+/**
+ * @brief 
+ * Recomputes the running sum of every stage of a moving average cascade from its history,
+ * so that rounding in the running sums cannot drift. Called whenever the ring wraps.
+ * @param filter Moving average cascade
+ */
+static void moving_average_cascade_refresh(MovingAverageCascadeReal *filter);
+
+/**
+ * @brief 
+ * Replaces the oldest value of a window in its mean and sum of squared deviations.
+ * This is Welford's update for adding a value combined with the one for removing a value.
+ * @param mean Mean of the window
+ * @param squared_deviation_sum Sum of squared deviations from the mean
+ * @param input Value entering the window
+ * @param oldest Value leaving the window
+ * @param inverse_length Reciprocal of the window length
+ */
+static inline void moving_stats_update(
+    double *mean,
+    double *squared_deviation_sum,
+    double input,
+    double oldest,
+    double inverse_length
+);
+
+/**
+ * @brief 
+ * Recomputes the mean and sum of squared deviations of windows of one or more channels with two passes.
+ * Both passes walk the frames in order with the channel index innermost.
+ * @param frames Frames in the window, oldest first, each holding one value of every channel
+ * @param length Number of frames
+ * @param n_channels Number of values in each frame
+ * @param mean Mean of each channel
+ * @param squared_deviation_sum Sum of squared deviations of each channel from its mean
+ */
+static void moving_stats_refresh(
+    const double *restrict frames,
+    size_t length,
+    size_t n_channels,
+    double *restrict mean,
+    double *restrict squared_deviation_sum
+);
+
+/**
+ * @brief 
+ * Derives the reported statistics from the mean and sum of squared deviations
+ * @param mean Mean of the window
+ * @param squared_deviation_sum Sum of squared deviations from the mean
+ * @param inverse_length Reciprocal of the window length
+ * @return Statistics of the window
+ */
+static inline Statistics moving_stats_statistics(
+    double mean,
+    double squared_deviation_sum,
+    double inverse_length
+);
+
 #define MOVING_AVERAGE_MAKE(moving_average_type, circbuf_constructor) \
     moving_average_type *filter = malloc(sizeof(moving_average_type)); \
     \
@@ -15,16 +82,17 @@
     } \
     \
     filter->moving_sum = 0; \
+    filter->inverse_length = 1.0 / length; \
     \
     return filter;
 
 
 MovingAverageReal *moving_average_real_make(size_t length) {
-    MOVING_AVERAGE_MAKE(MovingAverageReal, vector_real_new)
+    MOVING_AVERAGE_MAKE(MovingAverageReal, vector_real_new_contiguous)
 }
 
 MovingAverageComplex *moving_average_complex_make(size_t length) {
-    MOVING_AVERAGE_MAKE(MovingAverageComplex, vector_complex_new)
+    MOVING_AVERAGE_MAKE(MovingAverageComplex, vector_complex_new_contiguous)
 }
 
 size_t moving_average_complex_length(MovingAverageComplex *filter) {
@@ -34,9 +102,8 @@ size_t moving_average_complex_length(MovingAverageComplex *filter) {
 #define MOVING_AVERAGE_EVALUATE(circbuf_shifter) \
     assert_not_null(filter); \
     \
-    filter->moving_sum += input; \
-    filter->moving_sum -= circbuf_shifter(input, filter->previous_input); \
-    return filter->moving_sum / filter->previous_input->n_elements; 
+    filter->moving_sum += input - circbuf_shifter(input, filter->previous_input); \
+    return filter->moving_sum * filter->inverse_length; 
 
 double moving_average_real_evaluate(
     double input, 
@@ -52,6 +119,59 @@ double complex moving_average_complex_evaluate(
     MOVING_AVERAGE_EVALUATE(vector_complex_shift)
 }
 
+/**
+ * @brief 
+ * Evaluates a moving average over a block.
+ * After the block shift, the history holds the previous window followed by the block,
+ * so input `i` replaces `history[i]` and is itself `history[n + i]`.
+ * The running differences are computed first in a loop with no dependencies,
+ * which vectorizes, and the running sum is then a single prefix-sum pass.
+ * The sums are rounded in the same order as `MOVING_AVERAGE_EVALUATE`.
+ */
+#define MOVING_AVERAGE_PROCESS_BLOCK(element_type) \
+    assert_not_null(filter); \
+    assert(length == 0 || (input != NULL && output != NULL)); \
+    \
+    size_t n = vector_length_generic(filter->previous_input); \
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input); \
+    while (length > 0) { \
+        size_t block_length = length < block_limit ? length : block_limit; \
+        const element_type *history = \
+            vector_shift_block_generic(input, block_length, filter->previous_input); \
+        \
+        for (size_t i = 0; i < block_length; i++) { \
+            output[i] = history[n + i] - history[i]; \
+        } \
+        element_type moving_sum = filter->moving_sum; \
+        for (size_t i = 0; i < block_length; i++) { \
+            moving_sum += output[i]; \
+            output[i] = moving_sum * filter->inverse_length; \
+        } \
+        filter->moving_sum = moving_sum; \
+        \
+        input += block_length; \
+        output += block_length; \
+        length -= block_length; \
+    }
+
+void moving_average_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    MovingAverageReal *filter
+) {
+    MOVING_AVERAGE_PROCESS_BLOCK(double)
+}
+
+void moving_average_complex_process_block(
+    const double complex *input,
+    double complex *output,
+    size_t length,
+    MovingAverageComplex *filter
+) {
+    MOVING_AVERAGE_PROCESS_BLOCK(double complex)
+}
+
 #define MOVING_AVERAGE_RESET(circbuf_resetter) \
     assert_not_null(filter); \
     \
@@ -81,3 +201,416 @@ void moving_average_real_free(MovingAverageReal *filter) {
 void moving_average_complex_free(MovingAverageComplex *filter) {
     MOVING_AVERAGE_FREE
 }
+
+MovingAverageCascadeReal *moving_average_cascade_real_make(size_t length, size_t n_stages) {
+    assert(length > 0);
+    assert(n_stages > 0);
+
+    MovingAverageCascadeReal *filter = malloc(sizeof(MovingAverageCascadeReal));
+    if (filter == NULL)
+        return NULL;
+
+    filter->moving_sums = malloc(n_stages * sizeof(double));
+    if (filter->moving_sums == NULL)
+        goto fail_allocate_moving_sums;
+
+    filter->previous_input = malloc(n_stages * length * sizeof(double));
+    if (filter->previous_input == NULL)
+        goto fail_allocate_previous_input;
+
+    filter->length = length;
+    filter->n_stages = n_stages;
+    filter->scale = pow(length, -(double) n_stages);
+    moving_average_cascade_real_reset(filter);
+    return filter;
+
+fail_allocate_previous_input:
+    free(filter->moving_sums);
+fail_allocate_moving_sums:
+    free(filter);
+    return NULL;
+}
+
+double moving_average_cascade_real_evaluate(double input, MovingAverageCascadeReal *filter) {
+    assert_not_null(filter);
+
+    size_t length = filter->length;
+    double value = input;
+    for (size_t k = 0; k < filter->n_stages; k++) {
+        double *oldest = &filter->previous_input[k * length + filter->oldest];
+        double difference = value - *oldest;
+        *oldest = value;
+        filter->moving_sums[k] += difference;
+        value = filter->moving_sums[k];
+    }
+    if (++filter->oldest == length) {
+        filter->oldest = 0;
+        moving_average_cascade_refresh(filter);
+    }
+    return value * filter->scale;
+}
+
+void moving_average_cascade_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    MovingAverageCascadeReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    /**
+     * @brief 
+     * Blocks end at the end of the ring, so every input leaving a stage comes from its history,
+     * and the running sums are recomputed after the same input as in `moving_average_cascade_real_evaluate`
+     */
+    size_t window_length = filter->length;
+    size_t block_limit = MOVING_AVERAGE_CASCADE_BLOCK_LENGTH;
+
+    double stage[MOVING_AVERAGE_CASCADE_BLOCK_LENGTH];
+    double difference[MOVING_AVERAGE_CASCADE_BLOCK_LENGTH];
+    while (length > 0) {
+        size_t block_length = length < block_limit ? length : block_limit;
+        if (block_length > window_length - filter->oldest)
+            block_length = window_length - filter->oldest;
+
+        for (size_t i = 0; i < block_length; i++) {
+            stage[i] = input[i];
+        }
+
+        for (size_t k = 0; k < filter->n_stages; k++) {
+            double *oldest = &filter->previous_input[k * window_length + filter->oldest];
+
+            /**
+             * @brief 
+             * Running differences against the stored history vectorize, 
+             * leaving only the prefix sum as a serial dependency
+             */
+            for (size_t i = 0; i < block_length; i++) {
+                difference[i] = stage[i] - oldest[i];
+                oldest[i] = stage[i];
+            }
+
+            double moving_sum = filter->moving_sums[k];
+            for (size_t i = 0; i < block_length; i++) {
+                moving_sum += difference[i];
+                stage[i] = moving_sum;
+            }
+            filter->moving_sums[k] = moving_sum;
+        }
+
+        for (size_t i = 0; i < block_length; i++) {
+            output[i] = stage[i] * filter->scale;
+        }
+        filter->oldest += block_length;
+        if (filter->oldest == window_length) {
+            filter->oldest = 0;
+            moving_average_cascade_refresh(filter);
+        }
+
+        input += block_length;
+        output += block_length;
+        length -= block_length;
+    }
+}
+
+void moving_average_cascade_real_reset(MovingAverageCascadeReal *filter) {
+    assert_not_null(filter);
+
+    for (size_t k = 0; k < filter->n_stages; k++) {
+        filter->moving_sums[k] = 0;
+    }
+    for (size_t i = 0; i < filter->n_stages * filter->length; i++) {
+        filter->previous_input[i] = 0;
+    }
+    filter->oldest = 0;
+}
+
+void moving_average_cascade_real_free(MovingAverageCascadeReal *filter) {
+    assert_not_null(filter);
+
+    free(filter->moving_sums);
+    free(filter->previous_input);
+    free(filter);
+}
+
+MovingStatsReal *moving_stats_real_make(size_t length) {
+    assert(length > 0);
+
+    MovingStatsReal *filter = malloc(sizeof(MovingStatsReal));
+    if (filter == NULL)
+        return NULL;
+
+    filter->previous_input = vector_real_new_contiguous(length);
+    if (filter->previous_input == NULL) {
+        free(filter);
+        return NULL;
+    }
+
+    filter->inverse_length = 1.0 / length;
+    moving_stats_real_reset(filter);
+    return filter;
+}
+
+Statistics moving_stats_real_evaluate(double input, MovingStatsReal *filter) {
+    assert_not_null(filter);
+
+    double oldest = vector_real_shift(input, filter->previous_input);
+    moving_stats_update(
+        &filter->mean, &filter->squared_deviation_sum, input, oldest, filter->inverse_length
+    );
+
+    if (--filter->n_until_refresh == 0) {
+        size_t length = vector_length_generic(filter->previous_input);
+        moving_stats_refresh(
+            vector_contiguous_elements_generic(filter->previous_input), length, 1,
+            &filter->mean, &filter->squared_deviation_sum
+        );
+        filter->n_until_refresh = length;
+    }
+    return moving_stats_statistics(
+        filter->mean, filter->squared_deviation_sum, filter->inverse_length
+    );
+}
+
+void moving_stats_real_process_block(
+    const double *input,
+    Statistics *output,
+    size_t length,
+    MovingStatsReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t window_length = vector_length_generic(filter->previous_input);
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input);
+    while (length > 0) {
+        size_t block_length = length < block_limit ? length : block_limit;
+        const double *history =
+            vector_shift_block_generic(input, block_length, filter->previous_input);
+
+        /**
+         * @brief 
+         * Input `i` of the block replaces `history[i]`, 
+         * and the window after it starts at `history[i + 1]`
+         */
+        for (size_t i = 0; i < block_length; i++) {
+            moving_stats_update(
+                &filter->mean, &filter->squared_deviation_sum, 
+                input[i], history[i], filter->inverse_length
+            );
+            if (--filter->n_until_refresh == 0) {
+                moving_stats_refresh(
+                    &history[i + 1], window_length, 1,
+                    &filter->mean, &filter->squared_deviation_sum
+                );
+                filter->n_until_refresh = window_length;
+            }
+            output[i] = moving_stats_statistics(
+                filter->mean, filter->squared_deviation_sum, filter->inverse_length
+            );
+        }
+
+        input += block_length;
+        output += block_length;
+        length -= block_length;
+    }
+}
+
+void moving_stats_real_reset(MovingStatsReal *filter) {
+    assert_not_null(filter);
+
+    vector_reset_generic(filter->previous_input);
+    filter->mean = 0;
+    filter->squared_deviation_sum = 0;
+    filter->n_until_refresh = vector_length_generic(filter->previous_input);
+}
+
+void moving_stats_real_free(MovingStatsReal *filter) {
+    assert_not_null(filter);
+
+    vector_free_generic(filter->previous_input);
+    free(filter);
+}
+
+MovingStatsBankReal *moving_stats_bank_real_make(size_t length, size_t n_channels) {
+    assert(length > 0);
+    assert(n_channels > 0);
+
+    MovingStatsBankReal *filter = malloc(sizeof(MovingStatsBankReal));
+    if (filter == NULL)
+        return NULL;
+
+    filter->mean = malloc(n_channels * sizeof(double));
+    if (filter->mean == NULL)
+        goto fail_allocate_mean;
+
+    filter->squared_deviation_sum = malloc(n_channels * sizeof(double));
+    if (filter->squared_deviation_sum == NULL)
+        goto fail_allocate_squared_deviation_sum;
+
+    filter->previous_input = malloc(length * n_channels * sizeof(double));
+    if (filter->previous_input == NULL)
+        goto fail_allocate_previous_input;
+
+    filter->n_channels = n_channels;
+    filter->length = length;
+    filter->inverse_length = 1.0 / length;
+    moving_stats_bank_real_reset(filter);
+    return filter;
+
+fail_allocate_previous_input:
+    free(filter->squared_deviation_sum);
+fail_allocate_squared_deviation_sum:
+    free(filter->mean);
+fail_allocate_mean:
+    free(filter);
+    return NULL;
+}
+
+void moving_stats_bank_real_evaluate(
+    const double *input,
+    double *mean,
+    double *variance,
+    double *rms,
+    MovingStatsBankReal *filter
+) {
+    assert_not_null(filter);
+    assert_not_null(input);
+    assert_not_null(mean);
+    assert_not_null(variance);
+
+    size_t n_channels = filter->n_channels;
+    double inverse_length = filter->inverse_length;
+    double *restrict channel_mean = filter->mean;
+    double *restrict channel_squared_deviation_sum = filter->squared_deviation_sum;
+    double *restrict oldest = &filter->previous_input[filter->oldest_frame * n_channels];
+
+    for (size_t c = 0; c < n_channels; c++) {
+        moving_stats_update(
+            &channel_mean[c], &channel_squared_deviation_sum[c],
+            input[c], oldest[c], inverse_length
+        );
+        oldest[c] = input[c];
+    }
+
+    filter->oldest_frame = filter->oldest_frame + 1 == filter->length ? 0 : filter->oldest_frame + 1;
+    if (--filter->n_until_refresh == 0) {
+        /**
+         * @brief 
+         * The ring has just wrapped, so its frames are in order from oldest to newest
+         */
+        moving_stats_refresh(
+            filter->previous_input, filter->length, n_channels,
+            channel_mean, channel_squared_deviation_sum
+        );
+        filter->n_until_refresh = filter->length;
+    }
+
+    for (size_t c = 0; c < n_channels; c++) {
+        mean[c] = channel_mean[c];
+        variance[c] = channel_squared_deviation_sum[c] > 0 ? 
+            channel_squared_deviation_sum[c] * inverse_length : 
+            0;
+    }
+    if (rms != NULL) {
+        for (size_t c = 0; c < n_channels; c++) {
+            rms[c] = sqrt(variance[c] + mean[c] * mean[c]);
+        }
+    }
+}
+
+void moving_stats_bank_real_reset(MovingStatsBankReal *filter) {
+    assert_not_null(filter);
+
+    for (size_t c = 0; c < filter->n_channels; c++) {
+        filter->mean[c] = 0;
+        filter->squared_deviation_sum[c] = 0;
+    }
+    for (size_t i = 0; i < filter->length * filter->n_channels; i++) {
+        filter->previous_input[i] = 0;
+    }
+    filter->oldest_frame = 0;
+    filter->n_until_refresh = filter->length;
+}
+
+void moving_stats_bank_real_free(MovingStatsBankReal *filter) {
+    assert_not_null(filter);
+
+    free(filter->mean);
+    free(filter->squared_deviation_sum);
+    free(filter->previous_input);
+    free(filter);
+}
+
+static void moving_average_cascade_refresh(MovingAverageCascadeReal *filter) {
+    for (size_t k = 0; k < filter->n_stages; k++) {
+        const double *history = &filter->previous_input[k * filter->length];
+        double moving_sum = 0;
+        for (size_t i = 0; i < filter->length; i++) {
+            moving_sum += history[i];
+        }
+        filter->moving_sums[k] = moving_sum;
+    }
+}
+
+static inline void moving_stats_update(
+    double *mean,
+    double *squared_deviation_sum,
+    double input,
+    double oldest,
+    double inverse_length
+) {
+    double previous_mean = *mean;
+    double difference = input - oldest;
+    *mean = previous_mean + difference * inverse_length;
+    *squared_deviation_sum += difference * (input - *mean + oldest - previous_mean);
+}
+
+static void moving_stats_refresh(
+    const double *restrict frames,
+    size_t length,
+    size_t n_channels,
+    double *restrict mean,
+    double *restrict squared_deviation_sum
+) {
+    for (size_t c = 0; c < n_channels; c++) {
+        mean[c] = 0;
+        squared_deviation_sum[c] = 0;
+    }
+    for (size_t i = 0; i < length; i++) {
+        const double *frame = &frames[i * n_channels];
+        for (size_t c = 0; c < n_channels; c++) {
+            mean[c] += frame[c];
+        }
+    }
+    for (size_t c = 0; c < n_channels; c++) {
+        mean[c] /= length;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        const double *frame = &frames[i * n_channels];
+        for (size_t c = 0; c < n_channels; c++) {
+            double deviation = frame[c] - mean[c];
+            squared_deviation_sum[c] += deviation * deviation;
+        }
+    }
+}
+
+static inline Statistics moving_stats_statistics(
+    double mean,
+    double squared_deviation_sum,
+    double inverse_length
+) {
+    /**
+     * @brief 
+     * Rounding in the sliding update can leave a slightly negative sum for a constant window
+     */
+    double variance = squared_deviation_sum > 0 ? squared_deviation_sum * inverse_length : 0;
+    return (Statistics) {
+        .mean = mean,
+        .variance = variance,
+        .standard_deviation = sqrt(variance),
+        .rms = sqrt(variance + mean * mean)
+    };
+}
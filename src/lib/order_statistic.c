@@ -0,0 +1,564 @@
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "order_statistic.h"
+#include "assertions.h"
+
+/**
+ * @brief 
+ * Moves a heap entry whose value changed to its correct position, up or down
+ * @param filter Filter containing the heap
+ * @param offset Position of the heap's root in `filter->heap`
+ * @param count Number of entries in the heap
+ * @param index Position of the changed entry, relative to the root
+ * @param is_max Whether the heap is a max-heap rather than a min-heap
+ */
+static void order_statistic_sift(
+    MovingOrderStatisticReal *filter,
+    size_t offset,
+    size_t count,
+    size_t index,
+    bool is_max
+);
+
+/**
+ * @brief 
+ * Whether a value belongs nearer the root of a heap than another
+ * @param a Value to test
+ * @param b Value to compare against
+ * @param is_max Whether the heap is a max-heap rather than a min-heap
+ * @return Whether `a` precedes `b`
+ */
+static inline bool order_statistic_precedes(double a, double b, bool is_max);
+
+/**
+ * @brief 
+ * Empties a monotonic queue and allocates its storage
+ * @param queue Queue to initialize
+ * @param capacity Maximum number of entries, the window length
+ * @return Whether the storage could be allocated
+ */
+static bool monotonic_queue_init(MonotonicQueueReal *queue, size_t capacity);
+
+/**
+ * @brief 
+ * Frees the storage of a monotonic queue
+ * @param queue Queue whose storage is freed
+ */
+static void monotonic_queue_free(MonotonicQueueReal *queue);
+
+/**
+ * @brief 
+ * Adds an input to the back of a monotonic queue.
+ * Entries that have left the window are removed from the front,
+ * and entries that can no longer be the extreme are removed from the back.
+ * @param queue Queue to update
+ * @param capacity Window length
+ * @param value Input value
+ * @param sample_index Sample number of the input
+ * @param is_max Whether the queue tracks the maximum rather than the minimum
+ */
+static inline void monotonic_queue_push(
+    MonotonicQueueReal *queue,
+    size_t capacity,
+    double value,
+    size_t sample_index,
+    bool is_max
+);
+
+/**
+ * @brief 
+ * Computes one extreme over every window of a block with the van Herk/Gil-Werman algorithm.
+ * The history is split into segments of the window length, so each window is a suffix
+ * of one segment followed by a prefix of the next.
+ * @param history Previous window followed by the block, as returned by `vector_real_shift_block`
+ * @param output Output whose maximum or minimum fields are written
+ * @param block_length Number of inputs in the block. Must be at least the window length.
+ * @param filter Filter providing the window length and workspace
+ * @param is_max Whether the maximum rather than the minimum is computed
+ */
+static void min_max_van_herk(
+    const double *history,
+    MinMax *output,
+    size_t block_length,
+    MovingMinMaxReal *filter,
+    bool is_max
+);
+
+/**
+ * @brief 
+ * Reads the extremes at the front of the queues of a sliding minimum and maximum filter
+ * @param filter Filter to read
+ * @param sample_index Sample number of the most recent input
+ * @return Minimum and maximum, and their ages
+ */
+static inline MinMax min_max_front(const MovingMinMaxReal *filter, size_t sample_index);
+
+MovingOrderStatisticReal *moving_order_statistic_real_make(size_t length, size_t rank) {
+    assert(length > 0);
+    assert(rank < length);
+
+    MovingOrderStatisticReal *filter = malloc(sizeof(MovingOrderStatisticReal));
+    if (filter == NULL)
+        return NULL;
+
+    filter->window = malloc(length * sizeof(double));
+    if (filter->window == NULL)
+        goto fail_allocate_window;
+
+    filter->heap = malloc(length * sizeof(size_t));
+    if (filter->heap == NULL)
+        goto fail_allocate_heap;
+
+    filter->heap_position = malloc(length * sizeof(size_t));
+    if (filter->heap_position == NULL)
+        goto fail_allocate_heap_position;
+
+    filter->length = length;
+    filter->rank = rank;
+    moving_order_statistic_real_reset(filter);
+    return filter;
+
+fail_allocate_heap_position:
+    free(filter->heap);
+fail_allocate_heap:
+    free(filter->window);
+fail_allocate_window:
+    free(filter);
+    return NULL;
+}
+
+double moving_order_statistic_real_evaluate(double input, MovingOrderStatisticReal *filter) {
+    assert_not_null(filter);
+
+    size_t n_low = filter->rank + 1;
+    size_t n_high = filter->length - n_low;
+    double *window = filter->window;
+    size_t *heap = filter->heap;
+
+    /**
+     * @brief 
+     * The oldest input is overwritten in place, so it stays in the same heap
+     * and the heap sizes never change
+     */
+    size_t slot = filter->oldest;
+    filter->oldest = filter->oldest + 1 == filter->length ? 0 : filter->oldest + 1;
+    window[slot] = input;
+
+    size_t position = filter->heap_position[slot];
+    if (position < n_low)
+        order_statistic_sift(filter, 0, n_low, position, true);
+    else
+        order_statistic_sift(filter, n_low, n_high, position - n_low, false);
+
+    /**
+     * @brief 
+     * Every value in the low heap was at most every value in the high heap before the update,
+     * so exchanging the roots once restores that order
+     */
+    if (n_high > 0 && window[heap[0]] > window[heap[n_low]]) {
+        size_t low_root = heap[0];
+        heap[0] = heap[n_low];
+        heap[n_low] = low_root;
+        filter->heap_position[heap[0]] = 0;
+        filter->heap_position[heap[n_low]] = n_low;
+        order_statistic_sift(filter, 0, n_low, 0, true);
+        order_statistic_sift(filter, n_low, n_high, 0, false);
+    }
+    return window[heap[0]];
+}
+
+void moving_order_statistic_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    MovingOrderStatisticReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    for (size_t i = 0; i < length; i++) {
+        output[i] = moving_order_statistic_real_evaluate(input[i], filter);
+    }
+}
+
+void moving_order_statistic_real_reset(MovingOrderStatisticReal *filter) {
+    assert_not_null(filter);
+
+    /**
+     * @brief 
+     * Every value is zero, so any split of the slots between the heaps is ordered
+     */
+    for (size_t i = 0; i < filter->length; i++) {
+        filter->window[i] = 0;
+        filter->heap[i] = i;
+        filter->heap_position[i] = i;
+    }
+    filter->oldest = 0;
+}
+
+void moving_order_statistic_real_free(MovingOrderStatisticReal *filter) {
+    assert_not_null(filter);
+
+    free(filter->window);
+    free(filter->heap);
+    free(filter->heap_position);
+    free(filter);
+}
+
+MovingMedianReal *moving_median_real_make(size_t length) {
+    return moving_order_statistic_real_make(length, (length - 1) / 2);
+}
+
+double moving_median_real_evaluate(double input, MovingMedianReal *filter) {
+    double lower_median = moving_order_statistic_real_evaluate(input, filter);
+    if (filter->length % 2 == 1)
+        return lower_median;
+
+    /**
+     * @brief 
+     * For even lengths the low heap holds exactly half of the window,
+     * so the root of the high heap is the upper middle value
+     */
+    double upper_median = filter->window[filter->heap[filter->rank + 1]];
+    return (lower_median + upper_median) / 2;
+}
+
+void moving_median_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    MovingMedianReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    for (size_t i = 0; i < length; i++) {
+        output[i] = moving_median_real_evaluate(input[i], filter);
+    }
+}
+
+void moving_median_real_reset(MovingMedianReal *filter) {
+    moving_order_statistic_real_reset(filter);
+}
+
+void moving_median_real_free(MovingMedianReal *filter) {
+    moving_order_statistic_real_free(filter);
+}
+
+MovingMinMaxReal *moving_min_max_real_make(size_t length) {
+    assert(length > 0);
+
+    MovingMinMaxReal *filter = malloc(sizeof(MovingMinMaxReal));
+    if (filter == NULL)
+        return NULL;
+
+    filter->previous_input = vector_real_new_contiguous(length);
+    if (filter->previous_input == NULL)
+        goto fail_allocate_previous_input;
+
+    if (!monotonic_queue_init(&filter->max_queue, length))
+        goto fail_allocate_max_queue;
+
+    if (!monotonic_queue_init(&filter->min_queue, length))
+        goto fail_allocate_min_queue;
+
+    /**
+     * @brief 
+     * Suffix extremes are only needed for the starts of the windows in one block
+     */
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input);
+    filter->suffix_values = malloc((block_limit + 1) * sizeof(double));
+    if (filter->suffix_values == NULL)
+        goto fail_allocate_suffix_values;
+
+    filter->suffix_indices = malloc((block_limit + 1) * sizeof(size_t));
+    if (filter->suffix_indices == NULL)
+        goto fail_allocate_suffix_indices;
+
+    filter->length = length;
+    moving_min_max_real_reset(filter);
+    return filter;
+
+fail_allocate_suffix_indices:
+    free(filter->suffix_values);
+fail_allocate_suffix_values:
+    monotonic_queue_free(&filter->min_queue);
+fail_allocate_min_queue:
+    monotonic_queue_free(&filter->max_queue);
+fail_allocate_max_queue:
+    vector_free_generic(filter->previous_input);
+fail_allocate_previous_input:
+    free(filter);
+    return NULL;
+}
+
+MinMax moving_min_max_real_evaluate(double input, MovingMinMaxReal *filter) {
+    assert_not_null(filter);
+
+    vector_shift_generic(input, filter->previous_input);
+    size_t sample_index = filter->n_inputs++;
+    monotonic_queue_push(&filter->max_queue, filter->length, input, sample_index, true);
+    monotonic_queue_push(&filter->min_queue, filter->length, input, sample_index, false);
+    return min_max_front(filter, sample_index);
+}
+
+void moving_min_max_real_process_block(
+    const double *input,
+    MinMax *output,
+    size_t length,
+    MovingMinMaxReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t window_length = filter->length;
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input);
+    while (length > 0) {
+        size_t block_length = length < block_limit ? length : block_limit;
+        const double *history =
+            vector_shift_block_generic(input, block_length, filter->previous_input);
+
+        if (block_length < window_length) {
+            for (size_t i = 0; i < block_length; i++) {
+                size_t sample_index = filter->n_inputs++;
+                monotonic_queue_push(&filter->max_queue, window_length, input[i], sample_index, true);
+                monotonic_queue_push(&filter->min_queue, window_length, input[i], sample_index, false);
+                output[i] = min_max_front(filter, sample_index);
+            }
+        }
+        else {
+            min_max_van_herk(history, output, block_length, filter, true);
+            min_max_van_herk(history, output, block_length, filter, false);
+            filter->n_inputs += block_length;
+
+            /**
+             * @brief 
+             * The queues are rebuilt from the final window, which costs no more than the block itself
+             */
+            filter->max_queue.count = 0;
+            filter->min_queue.count = 0;
+            const double *window = &history[block_length];
+            size_t first_sample_index = filter->n_inputs - window_length;
+            for (size_t k = 0; k < window_length; k++) {
+                monotonic_queue_push(
+                    &filter->max_queue, window_length, window[k], first_sample_index + k, true
+                );
+                monotonic_queue_push(
+                    &filter->min_queue, window_length, window[k], first_sample_index + k, false
+                );
+            }
+        }
+
+        input += block_length;
+        output += block_length;
+        length -= block_length;
+    }
+}
+
+void moving_min_max_real_reset(MovingMinMaxReal *filter) {
+    assert_not_null(filter);
+
+    /**
+     * @brief 
+     * The initial zeros are all equal, so only the most recent one is queued
+     */
+    vector_reset_generic(filter->previous_input);
+    filter->n_inputs = filter->length;
+    MonotonicQueueReal *queues[] = {&filter->max_queue, &filter->min_queue};
+    for (size_t i = 0; i < 2; i++) {
+        queues[i]->front = 0;
+        queues[i]->count = 1;
+        queues[i]->values[0] = 0;
+        queues[i]->sample_indices[0] = filter->length - 1;
+    }
+}
+
+void moving_min_max_real_free(MovingMinMaxReal *filter) {
+    assert_not_null(filter);
+
+    vector_free_generic(filter->previous_input);
+    monotonic_queue_free(&filter->max_queue);
+    monotonic_queue_free(&filter->min_queue);
+    free(filter->suffix_values);
+    free(filter->suffix_indices);
+    free(filter);
+}
+
+static void order_statistic_sift(
+    MovingOrderStatisticReal *filter,
+    size_t offset,
+    size_t count,
+    size_t index,
+    bool is_max
+) {
+    size_t *heap = &filter->heap[offset];
+    const double *window = filter->window;
+    size_t slot = heap[index];
+    double value = window[slot];
+
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!order_statistic_precedes(value, window[heap[parent]], is_max))
+            break;
+        heap[index] = heap[parent];
+        filter->heap_position[heap[index]] = offset + index;
+        index = parent;
+    }
+
+    while (true) {
+        size_t child = 2 * index + 1;
+        if (child >= count)
+            break;
+        if (child + 1 < count &&
+            order_statistic_precedes(window[heap[child + 1]], window[heap[child]], is_max))
+            child++;
+        if (!order_statistic_precedes(window[heap[child]], value, is_max))
+            break;
+        heap[index] = heap[child];
+        filter->heap_position[heap[index]] = offset + index;
+        index = child;
+    }
+
+    heap[index] = slot;
+    filter->heap_position[slot] = offset + index;
+}
+
+static inline bool order_statistic_precedes(double a, double b, bool is_max) {
+    return is_max ? a > b : a < b;
+}
+
+static bool monotonic_queue_init(MonotonicQueueReal *queue, size_t capacity) {
+    queue->values = malloc(capacity * sizeof(double));
+    if (queue->values == NULL)
+        return false;
+
+    queue->sample_indices = malloc(capacity * sizeof(size_t));
+    if (queue->sample_indices == NULL) {
+        free(queue->values);
+        return false;
+    }
+
+    queue->front = 0;
+    queue->count = 0;
+    return true;
+}
+
+static void monotonic_queue_free(MonotonicQueueReal *queue) {
+    free(queue->values);
+    free(queue->sample_indices);
+}
+
+static inline void monotonic_queue_push(
+    MonotonicQueueReal *queue,
+    size_t capacity,
+    double value,
+    size_t sample_index,
+    bool is_max
+) {
+    /**
+     * @brief 
+     * Expired entries are removed first, so the queue never holds more than `capacity` entries.
+     * Equal values are removed from the back, so the most recent occurrence of the extreme is kept.
+     */
+    while (queue->count > 0 && queue->sample_indices[queue->front] + capacity <= sample_index) {
+        queue->front = queue->front + 1 == capacity ? 0 : queue->front + 1;
+        queue->count--;
+    }
+
+    while (queue->count > 0) {
+        size_t back = queue->front + queue->count - 1;
+        back = back >= capacity ? back - capacity : back;
+        if (order_statistic_precedes(queue->values[back], value, is_max))
+            break;
+        queue->count--;
+    }
+
+    size_t position = queue->front + queue->count;
+    position = position >= capacity ? position - capacity : position;
+    queue->values[position] = value;
+    queue->sample_indices[position] = sample_index;
+    queue->count++;
+}
+
+static void min_max_van_herk(
+    const double *history,
+    MinMax *output,
+    size_t block_length,
+    MovingMinMaxReal *filter,
+    bool is_max
+) {
+    size_t window_length = filter->length;
+    double *suffix_values = filter->suffix_values;
+    size_t *suffix_indices = filter->suffix_indices;
+
+    /**
+     * @brief 
+     * The window for output `i` is `history[i + 1]` through `history[i + window_length]`.
+     * Suffix extremes run from each window start to the end of its segment,
+     * preferring the later position on ties.
+     */
+    for (size_t segment_start = 0; segment_start <= block_length; segment_start += window_length) {
+        size_t k = segment_start + window_length - 1;
+        double best_value = history[k];
+        size_t best_index = k;
+        while (true) {
+            if (order_statistic_precedes(history[k], best_value, is_max)) {
+                best_value = history[k];
+                best_index = k;
+            }
+            if (k <= block_length) {
+                suffix_values[k] = best_value;
+                suffix_indices[k] = best_index;
+            }
+            if (k == segment_start)
+                break;
+            k--;
+        }
+    }
+
+    /**
+     * @brief 
+     * Prefix extremes run from the start of each segment to each window end.
+     * A window that starts on a segment boundary is exactly one prefix.
+     */
+    double prefix_value = 0;
+    size_t prefix_index = 0;
+    for (size_t i = 0; i < block_length; i++) {
+        size_t end = i + window_length;
+        if (end % window_length == 0 ||
+            !order_statistic_precedes(prefix_value, history[end], is_max)) {
+            prefix_value = history[end];
+            prefix_index = end;
+        }
+
+        double value = prefix_value;
+        size_t index = prefix_index;
+        size_t start = i + 1;
+        if (start % window_length != 0 &&
+            order_statistic_precedes(suffix_values[start], prefix_value, is_max)) {
+            value = suffix_values[start];
+            index = suffix_indices[start];
+        }
+
+        if (is_max) {
+            output[i].max = value;
+            output[i].max_age = end - index;
+        }
+        else {
+            output[i].min = value;
+            output[i].min_age = end - index;
+        }
+    }
+}
+
+static inline MinMax min_max_front(const MovingMinMaxReal *filter, size_t sample_index) {
+    const MonotonicQueueReal *max_queue = &filter->max_queue;
+    const MonotonicQueueReal *min_queue = &filter->min_queue;
+    return (MinMax) {
+        .min = min_queue->values[min_queue->front],
+        .max = max_queue->values[max_queue->front],
+        .min_age = sample_index - min_queue->sample_indices[min_queue->front],
+        .max_age = sample_index - max_queue->sample_indices[max_queue->front]
+    };
+}
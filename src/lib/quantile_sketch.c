@@ -0,0 +1,211 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include "quantile_sketch.h"
+#include "assertions.h"
+
+/**
+ * @brief 
+ * Finds the histogram bucket of a value.
+ * Buckets are in order of value: negative magnitudes from largest to smallest, zero, then positive magnitudes.
+ * @param input Value to place
+ * @param sketch Sketch providing the bucket boundaries
+ * @return Bucket index
+ */
+static inline size_t quantile_sketch_bucket(double input, const QuantileSketchReal *sketch);
+
+/**
+ * @brief 
+ * Completes the sub-window being filled.
+ * Merges it into the window histogram, removes the oldest sub-window, and starts filling that one.
+ * @param sketch Sketch to update
+ */
+static void quantile_sketch_advance(QuantileSketchReal *sketch);
+
+QuantileSketchReal *quantile_sketch_real_make(
+    size_t block_length,
+    size_t n_blocks,
+    double relative_accuracy,
+    double min_magnitude,
+    double max_magnitude
+) {
+    assert(block_length > 0 && block_length <= UINT32_MAX);
+    assert(n_blocks > 0);
+    assert(relative_accuracy > 0 && relative_accuracy < 1);
+    assert(min_magnitude > 0 && min_magnitude < max_magnitude);
+
+    QuantileSketchReal *sketch = malloc(sizeof(QuantileSketchReal));
+    if (sketch == NULL)
+        return NULL;
+
+    /**
+     * @brief 
+     * A bucket covers magnitudes from gamma^(k - 1) to gamma^k.
+     * Its representative value 2 gamma^k / (gamma + 1) is within `relative_accuracy` of both ends.
+     */
+    double gamma = (1 + relative_accuracy) / (1 - relative_accuracy);
+    sketch->log_gamma = log(gamma);
+    sketch->min_key = ceil(log(min_magnitude) / sketch->log_gamma);
+    sketch->n_magnitude_buckets =
+        (size_t) (ceil(log(max_magnitude) / sketch->log_gamma) - sketch->min_key) + 1;
+    sketch->block_length = block_length;
+    sketch->n_blocks = n_blocks;
+    size_t n_buckets = 2 * sketch->n_magnitude_buckets + 1;
+
+    sketch->bucket_values = malloc(sketch->n_magnitude_buckets * sizeof(double));
+    if (sketch->bucket_values == NULL)
+        goto fail_allocate_bucket_values;
+
+    sketch->block_counts = malloc((n_blocks + 1) * n_buckets * sizeof(uint32_t));
+    if (sketch->block_counts == NULL)
+        goto fail_allocate_block_counts;
+
+    sketch->cumulative_counts = malloc(n_buckets * sizeof(size_t));
+    if (sketch->cumulative_counts == NULL)
+        goto fail_allocate_cumulative_counts;
+
+    for (size_t k = 0; k < sketch->n_magnitude_buckets; k++) {
+        sketch->bucket_values[k] = 2 * exp((k + sketch->min_key) * sketch->log_gamma) / (gamma + 1);
+    }
+    quantile_sketch_real_reset(sketch);
+    return sketch;
+
+fail_allocate_cumulative_counts:
+    free(sketch->block_counts);
+fail_allocate_block_counts:
+    free(sketch->bucket_values);
+fail_allocate_bucket_values:
+    free(sketch);
+    return NULL;
+}
+
+void quantile_sketch_real_insert(double input, QuantileSketchReal *sketch) {
+    assert_not_null(sketch);
+
+    size_t n_buckets = 2 * sketch->n_magnitude_buckets + 1;
+    sketch->block_counts[sketch->filling_block * n_buckets + quantile_sketch_bucket(input, sketch)]++;
+    if (++sketch->n_block_inputs == sketch->block_length)
+        quantile_sketch_advance(sketch);
+}
+
+void quantile_sketch_real_insert_block(const double *input, size_t length, QuantileSketchReal *sketch) {
+    assert_not_null(sketch);
+    assert(length == 0 || input != NULL);
+
+    size_t n_buckets = 2 * sketch->n_magnitude_buckets + 1;
+    while (length > 0) {
+        size_t n_remaining = sketch->block_length - sketch->n_block_inputs;
+        size_t block_length = length < n_remaining ? length : n_remaining;
+
+        uint32_t *counts = &sketch->block_counts[sketch->filling_block * n_buckets];
+        for (size_t i = 0; i < block_length; i++) {
+            counts[quantile_sketch_bucket(input[i], sketch)]++;
+        }
+        sketch->n_block_inputs += block_length;
+        if (sketch->n_block_inputs == sketch->block_length)
+            quantile_sketch_advance(sketch);
+
+        input += block_length;
+        length -= block_length;
+    }
+}
+
+double quantile_sketch_real_quantile(double probability, const QuantileSketchReal *sketch) {
+    assert_not_null(sketch);
+    assert(probability >= 0 && probability <= 1);
+
+    size_t n = sketch->n_magnitude_buckets;
+    size_t n_buckets = 2 * n + 1;
+    size_t n_inputs = sketch->cumulative_counts[n_buckets - 1];
+    size_t rank = (size_t) round(probability * (n_inputs - 1));
+
+    /**
+     * @brief 
+     * Binary search for the first bucket whose cumulative count exceeds the rank
+     */
+    size_t low = 0;
+    size_t high = n_buckets - 1;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (sketch->cumulative_counts[middle] > rank)
+            high = middle;
+        else
+            low = middle + 1;
+    }
+
+    if (low == n)
+        return 0;
+    return low > n ? sketch->bucket_values[low - n - 1] : -sketch->bucket_values[n - 1 - low];
+}
+
+double quantile_sketch_real_evaluate(double input, double probability, QuantileSketchReal *sketch) {
+    quantile_sketch_real_insert(input, sketch);
+    return quantile_sketch_real_quantile(probability, sketch);
+}
+
+void quantile_sketch_real_reset(QuantileSketchReal *sketch) {
+    assert_not_null(sketch);
+
+    /**
+     * @brief 
+     * Every complete sub-window holds zeros, so that they leave the window as it fills
+     */
+    size_t n = sketch->n_magnitude_buckets;
+    size_t n_buckets = 2 * n + 1;
+    for (size_t block = 0; block <= sketch->n_blocks; block++) {
+        for (size_t b = 0; b < n_buckets; b++) {
+            sketch->block_counts[block * n_buckets + b] =
+                block > 0 && b == n ? (uint32_t) sketch->block_length : 0;
+        }
+    }
+    for (size_t b = 0; b < n_buckets; b++) {
+        sketch->cumulative_counts[b] = b >= n ? sketch->n_blocks * sketch->block_length : 0;
+    }
+    sketch->filling_block = 0;
+    sketch->n_block_inputs = 0;
+}
+
+void quantile_sketch_real_free(QuantileSketchReal *sketch) {
+    assert_not_null(sketch);
+
+    free(sketch->bucket_values);
+    free(sketch->block_counts);
+    free(sketch->cumulative_counts);
+    free(sketch);
+}
+
+static inline size_t quantile_sketch_bucket(double input, const QuantileSketchReal *sketch) {
+    size_t n = sketch->n_magnitude_buckets;
+    double magnitude = fabs(input);
+    double key = ceil(log(magnitude) / sketch->log_gamma) - sketch->min_key;
+    if (!(key >= 0))
+        return n;
+
+    size_t k = key < (double) n ? (size_t) key : n - 1;
+    return input > 0 ? n + 1 + k : n - 1 - k;
+}
+
+static void quantile_sketch_advance(QuantileSketchReal *sketch) {
+    size_t n_buckets = 2 * sketch->n_magnitude_buckets + 1;
+    size_t oldest_block = sketch->filling_block == sketch->n_blocks ? 0 : sketch->filling_block + 1;
+    const uint32_t *filling = &sketch->block_counts[sketch->filling_block * n_buckets];
+    uint32_t *oldest = &sketch->block_counts[oldest_block * n_buckets];
+
+    /**
+     * @brief 
+     * The window histogram is only stored as cumulative counts,
+     * so each bucket's count is recovered from the previous cumulative count before it is overwritten
+     */
+    size_t previous_cumulative = 0;
+    size_t cumulative = 0;
+    for (size_t b = 0; b < n_buckets; b++) {
+        size_t count = sketch->cumulative_counts[b] - previous_cumulative;
+        previous_cumulative = sketch->cumulative_counts[b];
+        cumulative += count + filling[b] - oldest[b];
+        sketch->cumulative_counts[b] = cumulative;
+        oldest[b] = 0;
+    }
+
+    sketch->filling_block = oldest_block;
+    sketch->n_block_inputs = 0;
+}
@@ -0,0 +1,462 @@
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+
+#include "resampler.h"
+#include "filter.h"
+#include "vector.h"
+#include "assertions.h"
+
+/**
+ * @brief 
+ * Greatest common divisor
+ * @param a Integer
+ * @param b Integer
+ * @return Greatest common divisor of `a` and `b`
+ */
+static size_t greatest_common_divisor(size_t a, size_t b);
+
+/**
+ * @brief 
+ * Farrow coefficients of cubic Lagrange interpolation through samples -1, 0, 1 and 2.
+ * Row k gives the coefficient of mu^k as a combination of the samples.
+ */
+static const double cubic_farrow_coefficients[4][4] = {
+    {0.0, 1.0, 0.0, 0.0},
+    {-1.0 / 3.0, -1.0 / 2.0, 1.0, -1.0 / 6.0},
+    {1.0 / 2.0, -1.0, 1.0 / 2.0, 0.0},
+    {-1.0 / 6.0, 1.0 / 2.0, -1.0 / 2.0, 1.0 / 6.0}
+};
+
+/**
+ * @brief 
+ * Farrow coefficients of quintic Lagrange interpolation through samples -2 to 3.
+ * Row k gives the coefficient of mu^k as a combination of the samples.
+ */
+static const double quintic_farrow_coefficients[6][6] = {
+    {0.0, 0.0, 1.0, 0.0, 0.0, 0.0},
+    {1.0 / 20.0, -1.0 / 2.0, -1.0 / 3.0, 1.0, -1.0 / 4.0, 1.0 / 30.0},
+    {-1.0 / 24.0, 2.0 / 3.0, -5.0 / 4.0, 2.0 / 3.0, -1.0 / 24.0, 0.0},
+    {-1.0 / 24.0, -1.0 / 24.0, 5.0 / 12.0, -7.0 / 12.0, 7.0 / 24.0, -1.0 / 24.0},
+    {1.0 / 24.0, -1.0 / 6.0, 1.0 / 4.0, -1.0 / 6.0, 1.0 / 24.0, 0.0},
+    {-1.0 / 120.0, 1.0 / 24.0, -1.0 / 12.0, 1.0 / 12.0, -1.0 / 24.0, 1.0 / 120.0}
+};
+
+/**
+ * @brief 
+ * Evaluates a Farrow interpolator
+ * @param samples `order + 1` consecutive samples, oldest first. 
+ * The interpolated interval is between samples `(order + 1) / 2 - 1` and `(order + 1) / 2`.
+ * @param stride Distance between consecutive samples in `samples`
+ * @param order Interpolation polynomial order
+ * @param mu Fractional position within the interpolated interval, from 0 to 1
+ * @return Interpolated value
+ */
+static double farrow_evaluate(
+    const double *samples, 
+    size_t stride, 
+    enum FarrowOrder order, 
+    double mu
+);
+
+/**
+ * @brief 
+ * Evaluates a real Farrow interpolator over a window of consecutive samples
+ * @param window `order + 1` consecutive samples, oldest first
+ * @param order Interpolation polynomial order
+ * @param mu Fractional position within the center interval of the window
+ * @return Interpolated value
+ */
+static double farrow_interpolate_real(
+    const double *window, 
+    enum FarrowOrder order, 
+    double mu
+);
+
+/**
+ * @brief 
+ * Evaluates a complex Farrow interpolator over a window of consecutive samples
+ * @param window `order + 1` consecutive samples, oldest first
+ * @param order Interpolation polynomial order
+ * @param mu Fractional position within the center interval of the window
+ * @return Interpolated value
+ */
+static double complex farrow_interpolate_complex(
+    const double complex *window, 
+    enum FarrowOrder order, 
+    double mu
+);
+
+RationalResamplerReal *resampler_rational_real_make(
+    size_t interpolation,
+    size_t decimation,
+    const VectorReal *prototype
+) {
+    assert(interpolation > 0);
+    assert(decimation > 0);
+    assert_valid_vector(prototype);
+
+    size_t divisor = greatest_common_divisor(interpolation, decimation);
+    interpolation /= divisor;
+    decimation /= divisor;
+
+    RationalResamplerReal *resampler = malloc(sizeof(RationalResamplerReal));
+    if (resampler == NULL)
+        goto resampler_allocation_failure;
+
+    size_t n_taps = vector_length_generic(prototype);
+    size_t taps_per_phase = (n_taps + interpolation - 1) / interpolation;
+
+    resampler->phase_coefficients =
+        malloc(sizeof(double) * interpolation * taps_per_phase);
+    if (resampler->phase_coefficients == NULL)
+        goto phase_coefficients_allocation_failure;
+
+    resampler->previous_input = vector_real_new_contiguous(taps_per_phase);
+    if (resampler->previous_input == NULL)
+        goto previous_input_allocation_failure;
+
+    resampler->interpolation = interpolation;
+    resampler->decimation = decimation;
+    resampler->taps_per_phase = taps_per_phase;
+
+    /**
+     * @brief 
+     * Branch p holds impulse response terms p, p + L, p + 2L, ...
+     * The impulse response runs from the last feedforward coefficient to the first.
+     * Branches are stored in reverse so that they line up with the delay line, oldest input first.
+     */
+    for (size_t phase = 0; phase < interpolation; phase++) {
+        double *branch = &resampler->phase_coefficients[phase * taps_per_phase];
+        for (size_t i = 0; i < taps_per_phase; i++) {
+            size_t response_index = phase + (taps_per_phase - 1 - i) * interpolation;
+            branch[i] = response_index < n_taps ?
+                *vector_real_element(n_taps - 1 - response_index, (VectorReal *) prototype) :
+                0.0;
+        }
+    }
+
+    resampler->phase = 0;
+    return resampler;
+
+    previous_input_allocation_failure:
+        free(resampler->phase_coefficients);
+    phase_coefficients_allocation_failure:
+        free(resampler);
+    resampler_allocation_failure:
+        return NULL;
+}
+
+RationalResamplerReal *resampler_rational_real_make_sinc(
+    size_t interpolation,
+    size_t decimation,
+    size_t taps_per_phase,
+    WindowFunction window
+) {
+    assert(interpolation > 0);
+    assert(decimation > 0);
+    assert(taps_per_phase > 0);
+
+    size_t divisor = greatest_common_divisor(interpolation, decimation);
+    interpolation /= divisor;
+    decimation /= divisor;
+
+    size_t rate_change = interpolation > decimation ? interpolation : decimation;
+    size_t length = interpolation * taps_per_phase;
+    if ((length & 0x1) == 0)
+        length--;
+
+    DigitalFilterReal *prototype =
+        filter_make_sinc(0.5 / rate_change, length, LOW_PASS, window);
+    if (prototype == NULL)
+        return NULL;
+
+    /**
+     * @brief 
+     * Zero-stuffing divides the signal power by L, so the prototype gain must be L.
+     * The designed coefficients are shared, so they are scaled in a copy.
+     */
+    VectorReal *scaled_prototype = vector_real_duplicate(prototype->feedforward);
+    filter_free_digital_filter_real(prototype);
+    if (scaled_prototype == NULL)
+        return NULL;
+    vector_real_scale(interpolation, scaled_prototype);
+
+    RationalResamplerReal *resampler =
+        resampler_rational_real_make(interpolation, decimation, scaled_prototype);
+    vector_real_free(scaled_prototype);
+    return resampler;
+}
+
+size_t resampler_rational_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    RationalResamplerReal *resampler
+) {
+    assert_not_null(resampler);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t taps_per_phase = resampler->taps_per_phase;
+    size_t block_limit = vector_shift_block_limit_generic(resampler->previous_input);
+
+    size_t n_outputs = 0;
+    while (length > 0) {
+        size_t block_length = length < block_limit ? length : block_limit;
+        const double *history =
+            vector_shift_block_generic(input, block_length, resampler->previous_input);
+
+        for (size_t i = 0; i < block_length; i++) {
+            const double *window = &history[i + 1];
+            for (
+                ;
+                resampler->phase < resampler->interpolation;
+                resampler->phase += resampler->decimation
+            ) {
+                const double *branch =
+                    &resampler->phase_coefficients[resampler->phase * taps_per_phase];
+                double sum = 0;
+                for (size_t j = 0; j < taps_per_phase; j++) {
+                    sum += branch[j] * window[j];
+                }
+                output[n_outputs++] = sum;
+            }
+            resampler->phase -= resampler->interpolation;
+        }
+
+        input += block_length;
+        length -= block_length;
+    }
+    return n_outputs;
+}
+
+void resampler_rational_real_reset(RationalResamplerReal *resampler) {
+    assert_not_null(resampler);
+
+    vector_reset_generic(resampler->previous_input);
+    resampler->phase = 0;
+}
+
+void resampler_rational_real_free(RationalResamplerReal *resampler) {
+    assert_not_null(resampler);
+
+    vector_free_generic(resampler->previous_input);
+    free(resampler->phase_coefficients);
+    free(resampler);
+}
+
+double resampler_farrow_real_interpolate(
+    double index, 
+    enum FarrowOrder order, 
+    const VectorReal *buf
+) {
+    assert_valid_vector(buf);
+    assert(order == FARROW_CUBIC || order == FARROW_QUINTIC);
+
+    double base = floor(index);
+    int first_index = (int) base - ((int) order + 1) / 2 + 1;
+    int n_points = order + 1;
+
+    const double *elements = vector_contiguous_elements_generic(buf);
+    if (
+        elements != NULL && 
+        first_index >= 0 && 
+        first_index + n_points <= (int) vector_length_generic(buf)
+    ) {
+        return farrow_interpolate_real(&elements[first_index], order, index - base);
+    }
+
+    double samples[FARROW_QUINTIC + 1];
+    for (int i = 0; i < n_points; i++) {
+        samples[i] = *vector_real_element(first_index + i, (VectorReal *) buf);
+    }
+    return farrow_interpolate_real(samples, order, index - base);
+}
+
+double complex resampler_farrow_complex_interpolate(
+    double index, 
+    enum FarrowOrder order, 
+    const VectorComplex *buf
+) {
+    assert_valid_vector(buf);
+    assert(order == FARROW_CUBIC || order == FARROW_QUINTIC);
+
+    double base = floor(index);
+    int first_index = (int) base - ((int) order + 1) / 2 + 1;
+    int n_points = order + 1;
+
+    const double complex *elements = vector_contiguous_elements_generic(buf);
+    if (
+        elements != NULL && 
+        first_index >= 0 && 
+        first_index + n_points <= (int) vector_length_generic(buf)
+    ) {
+        return farrow_interpolate_complex(&elements[first_index], order, index - base);
+    }
+
+    double complex samples[FARROW_QUINTIC + 1];
+    for (int i = 0; i < n_points; i++) {
+        samples[i] = *vector_complex_element(first_index + i, (VectorComplex *) buf);
+    }
+    return farrow_interpolate_complex(samples, order, index - base);
+}
+
+#define RESAMPLER_FARROW_MAKE(resampler_type, circbuf_constructor) \
+    assert(order == FARROW_CUBIC || order == FARROW_QUINTIC); \
+    \
+    resampler_type *resampler = malloc(sizeof(resampler_type)); \
+    if (resampler == NULL) { \
+        return NULL; \
+    } \
+    \
+    resampler->previous_input = circbuf_constructor(order + 1); \
+    if (resampler->previous_input == NULL) { \
+        free(resampler); \
+        return NULL; \
+    } \
+    \
+    resampler->order = order; \
+    resampler->offset = (order + 1) / 2; \
+    return resampler;
+
+FarrowResamplerReal *resampler_farrow_real_make(enum FarrowOrder order) {
+    RESAMPLER_FARROW_MAKE(FarrowResamplerReal, vector_real_new_contiguous)
+}
+
+FarrowResamplerComplex *resampler_farrow_complex_make(enum FarrowOrder order) {
+    RESAMPLER_FARROW_MAKE(FarrowResamplerComplex, vector_complex_new_contiguous)
+}
+
+/**
+ * @brief 
+ * After each input, every output whose position falls in the center interval of the 
+ * delay line is interpolated. The position then moves back by one input sample.
+ */
+#define RESAMPLER_FARROW_PROCESS_BLOCK(element_type, interpolate) \
+    assert_not_null(resampler); \
+    assert(length == 0 || (input != NULL && output != NULL)); \
+    assert(ratio > 0); \
+    \
+    double step = 1.0 / ratio; \
+    size_t block_limit = vector_shift_block_limit_generic(resampler->previous_input); \
+    \
+    size_t n_outputs = 0; \
+    while (length > 0) { \
+        size_t block_length = length < block_limit ? length : block_limit; \
+        const element_type *history = \
+            vector_shift_block_generic(input, block_length, resampler->previous_input); \
+        \
+        for (size_t i = 0; i < block_length; i++) { \
+            const element_type *window = &history[i + 1]; \
+            for (; resampler->offset < 1.0; resampler->offset += step) { \
+                output[n_outputs++] = interpolate(window, resampler->order, resampler->offset); \
+            } \
+            resampler->offset -= 1.0; \
+        } \
+        \
+        input += block_length; \
+        length -= block_length; \
+    } \
+    return n_outputs;
+
+size_t resampler_farrow_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    double ratio,
+    FarrowResamplerReal *resampler
+) {
+    RESAMPLER_FARROW_PROCESS_BLOCK(double, farrow_interpolate_real)
+}
+
+size_t resampler_farrow_complex_process_block(
+    const double complex *input,
+    double complex *output,
+    size_t length,
+    double ratio,
+    FarrowResamplerComplex *resampler
+) {
+    RESAMPLER_FARROW_PROCESS_BLOCK(double complex, farrow_interpolate_complex)
+}
+
+#define RESAMPLER_FARROW_RESET \
+    assert_not_null(resampler); \
+    \
+    vector_reset_generic(resampler->previous_input); \
+    resampler->offset = (resampler->order + 1) / 2;
+
+void resampler_farrow_real_reset(FarrowResamplerReal *resampler) {
+    RESAMPLER_FARROW_RESET
+}
+
+void resampler_farrow_complex_reset(FarrowResamplerComplex *resampler) {
+    RESAMPLER_FARROW_RESET
+}
+
+#define RESAMPLER_FARROW_FREE \
+    assert_not_null(resampler); \
+    \
+    vector_free_generic(resampler->previous_input); \
+    free(resampler);
+
+void resampler_farrow_real_free(FarrowResamplerReal *resampler) {
+    RESAMPLER_FARROW_FREE
+}
+
+void resampler_farrow_complex_free(FarrowResamplerComplex *resampler) {
+    RESAMPLER_FARROW_FREE
+}
+
+static double farrow_interpolate_real(
+    const double *window, 
+    enum FarrowOrder order, 
+    double mu
+) {
+    return farrow_evaluate(window, 1, order, mu);
+}
+
+static double complex farrow_interpolate_complex(
+    const double complex *window, 
+    enum FarrowOrder order, 
+    double mu
+) {
+    /**
+     * @brief 
+     * The coefficients are real, so the real and imaginary parts are interpolated separately
+     */
+    return CMPLX(
+        farrow_evaluate((const double *) window, 2, order, mu),
+        farrow_evaluate((const double *) window + 1, 2, order, mu)
+    );
+}
+
+static double farrow_evaluate(
+    const double *samples, 
+    size_t stride, 
+    enum FarrowOrder order, 
+    double mu
+) {
+    size_t n_points = order + 1;
+    const double *coefficients = order == FARROW_CUBIC ? 
+        &cubic_farrow_coefficients[0][0] : 
+        &quintic_farrow_coefficients[0][0];
+
+    double value = 0.0;
+    for (size_t k = n_points; k-- > 0;) {
+        double polynomial_coefficient = 0.0;
+        for (size_t j = 0; j < n_points; j++) {
+            polynomial_coefficient += coefficients[k * n_points + j] * samples[j * stride];
+        }
+        value = value * mu + polynomial_coefficient;
+    }
+    return value;
+}
+
+static size_t greatest_common_divisor(size_t a, size_t b) {
+    while (b != 0) {
+        size_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
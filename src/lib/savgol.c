@@ -1,4 +1,75 @@
 #include <assert.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "savgol.h"
+
+/**
+ * @brief 
+ * Maximum number of outputs computed together by `savgol_convolve`.
+ * Sized so that the accumulators stay resident in L1 cache.
+ */
+#define SAVGOL_BLOCK_LENGTH 256
+
+/**
+ * @brief 
+ * Convolves a signal with Savitzky-Golay weights
+ * @param weights Filter coefficients, in canonical order
+ * @param window Number of filter coefficients
+ * @param input Input signal values. Output `k` is computed from inputs `k` through `k + window - 1`.
+ * @param output Filtered values
+ * @param length Number of outputs
+ */
+static void savgol_convolve(
+    const double *restrict weights, 
+    int window, 
+    const double *restrict input, 
+    double *restrict output, 
+    size_t length
+);
+
+/**
+ * @brief 
+ * Evaluates the polynomials fitted to the first and last windows of a signal 
+ * at the outputs within half a window of either end.
+ * Each window is projected onto the Gram polynomials once, 
+ * so each edge output only evaluates the Gram polynomials at its own position.
+ * @param input Input signal values
+ * @param output Filtered values. Only the first and last `window / 2` are written.
+ * @param length Number of input values. Must be at least `window`.
+ * @param window Number of filter coefficients. Must be odd
+ * @param polyorder Order of polynomial used to perform the smoothing
+ * @param derivative Order of the derivative of the estimated value
+ * @return Whether the edges were filtered. Fails only if memory could not be allocated.
+ */
+static bool savgol_fit_edges(
+    const double *input, 
+    double *output, 
+    size_t length, 
+    int window, 
+    int polyorder, 
+    int derivative
+);
+
+/**
+ * @brief 
+ * Evaluates a derivative of a fitted polynomial, given its projections onto the Gram polynomials
+ * @param projections Weighted projection of the window onto each Gram polynomial order
+ * @param center Where to evaluate, relative to the middle of the window
+ * @param m Half the window length
+ * @param polyorder Order of the fitted polynomial
+ * @param derivative Order of the derivative
+ * @param polynomials Scratch space for `3 * (derivative + 1)` values
+ * @return Derivative of the fitted polynomial at `center`
+ */
+static double savgol_evaluate_fit(
+    const double *projections, 
+    int center, 
+    int m, 
+    int polyorder, 
+    int derivative, 
+    double *polynomials
+);
 
 static double gp(int i, int m, int k, int s) {
 
@@ -51,4 +122,309 @@ double savgol_weight(int i, int center, int window, int polyorder, int derivativ
 	w += (2*k+1)*(genfact(2*n,k)/genfact(2*n+k+1,k+1))*gp(i-n,n,k,0)*gp(center,n,k,derivative);
     }
     return w;
-}
\ No newline at end of file
+}
+
+bool savgol_weights(int center, int window, int polyorder, int max_derivative, double *weights) {
+    assert(window > 0);
+
+    /**
+     * @brief 
+     * Window length must be odd
+     */
+    assert((window & 0x1) == 1);
+
+    assert(polyorder >= 0);
+    assert(polyorder < window);
+    assert(max_derivative >= 0);
+    assert(weights != NULL);
+
+    int m = window / 2;
+    int n_derivatives = max_derivative + 1;
+
+    /**
+     * @brief 
+     * Gram polynomials of orders k, k - 1 and k - 2, at each data point and 
+     * (for each derivative order) at the estimated point
+     */
+    double *polynomials = calloc(3 * (window + n_derivatives), sizeof(double));
+    if (polynomials == NULL)
+        return false;
+    double *current = polynomials;
+    double *previous = current + window;
+    double *before_previous = previous + window;
+    double *center_current = before_previous + window;
+    double *center_previous = center_current + n_derivatives;
+    double *center_before_previous = center_previous + n_derivatives;
+
+    for (int i = 0; i < window * n_derivatives; i++) {
+        weights[i] = 0.0;
+    }
+
+    for (int k = 0; k <= polyorder; k++) {
+        if (k == 0) {
+            for (int i = 0; i < window; i++) {
+                current[i] = 1.0;
+            }
+            for (int s = 0; s < n_derivatives; s++) {
+                center_current[s] = s == 0 ? 1.0 : 0.0;
+            }
+        }
+        else {
+            /**
+             * @brief 
+             * Same three-term recurrence as `gp`, evaluated for all points at once
+             */
+            double a = (4.0*k-2.0)/(k*(2.0*m-k+1.0));
+            double b = ((k-1.0)*(2.0*m+k))/(k*(2.0*m-k+1.0));
+            for (int i = 0; i < window; i++) {
+                current[i] = a*((i-m)*previous[i]) - b*before_previous[i];
+            }
+            for (int s = 0; s < n_derivatives; s++) {
+                double lower_derivative = s > 0 ? center_previous[s-1] : 0.0;
+                center_current[s] = 
+                    a*(center*center_previous[s] + s*lower_derivative) - 
+                    b*center_before_previous[s];
+            }
+        }
+
+        double factor = (2*k+1)*(genfact(2*m,k)/genfact(2*m+k+1,k+1));
+        for (int s = 0; s < n_derivatives; s++) {
+            double center_factor = factor*center_current[s];
+            for (int i = 0; i < window; i++) {
+                weights[s * window + i] += center_factor*current[i];
+            }
+        }
+
+        double *recycled = before_previous;
+        before_previous = previous;
+        previous = current;
+        current = recycled;
+
+        double *center_recycled = center_before_previous;
+        center_before_previous = center_previous;
+        center_previous = center_current;
+        center_current = center_recycled;
+    }
+
+    free(polynomials);
+    return true;
+}
+
+bool savgol_filter(
+    const double *input, 
+    double *output, 
+    size_t length, 
+    int window, 
+    int polyorder, 
+    int derivative, 
+    enum SavgolMode mode
+) {
+    assert(input != NULL);
+    assert(output != NULL);
+    assert(window > 0);
+    assert((window & 0x1) == 1);
+    assert(length >= (size_t) window);
+    assert(derivative >= 0);
+    assert(derivative <= polyorder);
+    assert(mode == SAVGOL_MODE_INTERP || mode == SAVGOL_MODE_MIRROR || mode == SAVGOL_MODE_NEAREST);
+
+    size_t half_window = window / 2;
+    double *weights = malloc(sizeof(double) * window * (derivative + 1));
+    if (weights == NULL)
+        return false;
+
+    if (!savgol_weights(0, window, polyorder, derivative, weights)) {
+        free(weights);
+        return false;
+    }
+    const double *center_weights = &weights[derivative * window];
+    savgol_convolve(
+        center_weights, 
+        window, 
+        input, 
+        &output[half_window], 
+        length - 2 * half_window
+    );
+
+    if (mode == SAVGOL_MODE_INTERP) {
+        free(weights);
+        return savgol_fit_edges(input, output, length, window, polyorder, derivative);
+    }
+
+    /**
+     * @brief 
+     * The ends are extended by `half_window` samples, 
+     * and the edge outputs are convolved over the extended signal
+     */
+    double *extended = malloc(sizeof(double) * (window - 1 + half_window));
+    if (extended == NULL) {
+        free(weights);
+        return false;
+    }
+
+    for (size_t j = 0; j < window - 1 + half_window; j++) {
+        size_t distance = half_window - j;
+        extended[j] = j >= half_window ? input[j - half_window] : 
+            mode == SAVGOL_MODE_MIRROR ? input[distance] : input[0];
+    }
+    savgol_convolve(center_weights, window, extended, output, half_window);
+
+    for (size_t j = 0; j < window - 1 + half_window; j++) {
+        size_t index = length - (window - 1) + j;
+        size_t distance = index - (length - 1);
+        extended[j] = index < length ? input[index] : 
+            mode == SAVGOL_MODE_MIRROR ? input[length - 1 - distance] : input[length - 1];
+    }
+    savgol_convolve(center_weights, window, extended, &output[length - half_window], half_window);
+
+    free(extended);
+    free(weights);
+    return true;
+}
+
+static void savgol_convolve(
+    const double *restrict weights, 
+    int window, 
+    const double *restrict input, 
+    double *restrict output, 
+    size_t length
+) {
+    double accumulate[SAVGOL_BLOCK_LENGTH];
+    while (length > 0) {
+        size_t block_length = length < SAVGOL_BLOCK_LENGTH ? length : SAVGOL_BLOCK_LENGTH;
+        for (size_t k = 0; k < block_length; k++) {
+            accumulate[k] = 0.0;
+        }
+
+        /**
+         * @brief 
+         * Weights are the outer loop so that the inner loop runs across outputs and vectorizes
+         */
+        for (int i = 0; i < window; i++) {
+            double weight = weights[i];
+            const double *tap_input = &input[i];
+            for (size_t k = 0; k < block_length; k++) {
+                accumulate[k] += weight * tap_input[k];
+            }
+        }
+
+        for (size_t k = 0; k < block_length; k++) {
+            output[k] = accumulate[k];
+        }
+
+        input += block_length;
+        output += block_length;
+        length -= block_length;
+    }
+}
+
+static bool savgol_fit_edges(
+    const double *input, 
+    double *output, 
+    size_t length, 
+    int window, 
+    int polyorder, 
+    int derivative
+) {
+    int m = window / 2;
+    int n_orders = polyorder + 1;
+
+    /**
+     * @brief 
+     * Gram polynomials of orders k, k - 1 and k - 2 at each data point, 
+     * the projections of the first and last windows onto each order, 
+     * and scratch space for `savgol_evaluate_fit`
+     */
+    double *polynomials = calloc(3 * window + 2 * n_orders + 3 * (derivative + 1), sizeof(double));
+    if (polynomials == NULL)
+        return false;
+    double *current = polynomials;
+    double *previous = current + window;
+    double *before_previous = previous + window;
+    double *start_projections = before_previous + window;
+    double *end_projections = start_projections + n_orders;
+    double *scratch = end_projections + n_orders;
+
+    const double *last_window = &input[length - window];
+    for (int k = 0; k <= polyorder; k++) {
+        if (k == 0) {
+            for (int i = 0; i < window; i++) {
+                current[i] = 1.0;
+            }
+        }
+        else {
+            double a = (4.0*k-2.0)/(k*(2.0*m-k+1.0));
+            double b = ((k-1.0)*(2.0*m+k))/(k*(2.0*m-k+1.0));
+            for (int i = 0; i < window; i++) {
+                current[i] = a*((i-m)*previous[i]) - b*before_previous[i];
+            }
+        }
+
+        double start = 0;
+        double end = 0;
+        for (int i = 0; i < window; i++) {
+            start += current[i] * input[i];
+            end += current[i] * last_window[i];
+        }
+        double factor = (2*k+1)*(genfact(2*m,k)/genfact(2*m+k+1,k+1));
+        start_projections[k] = factor * start;
+        end_projections[k] = factor * end;
+
+        double *recycled = before_previous;
+        before_previous = previous;
+        previous = current;
+        current = recycled;
+    }
+
+    for (int p = 0; p < m; p++) {
+        int offset = m - p;
+        output[p] = savgol_evaluate_fit(start_projections, -offset, m, polyorder, derivative, scratch);
+        output[length - 1 - p] = savgol_evaluate_fit(end_projections, offset, m, polyorder, derivative, scratch);
+    }
+
+    free(polynomials);
+    return true;
+}
+
+static double savgol_evaluate_fit(
+    const double *projections, 
+    int center, 
+    int m, 
+    int polyorder, 
+    int derivative, 
+    double *polynomials
+) {
+    int n_derivatives = derivative + 1;
+    double *current = polynomials;
+    double *previous = current + n_derivatives;
+    double *before_previous = previous + n_derivatives;
+
+    /**
+     * @brief 
+     * Same recurrence as the estimated point in `savgol_weights`
+     */
+    double value = 0;
+    for (int k = 0; k <= polyorder; k++) {
+        if (k == 0) {
+            for (int s = 0; s < n_derivatives; s++) {
+                current[s] = s == 0 ? 1.0 : 0.0;
+                previous[s] = 0.0;
+            }
+        }
+        else {
+            double a = (4.0*k-2.0)/(k*(2.0*m-k+1.0));
+            double b = ((k-1.0)*(2.0*m+k))/(k*(2.0*m-k+1.0));
+            for (int s = 0; s < n_derivatives; s++) {
+                double lower_derivative = s > 0 ? previous[s-1] : 0.0;
+                current[s] = a*(center*previous[s] + s*lower_derivative) - b*before_previous[s];
+            }
+        }
+        value += projections[k] * current[derivative];
+
+        double *recycled = before_previous;
+        before_previous = previous;
+        previous = current;
+        current = recycled;
+    }
+    return value;
+}
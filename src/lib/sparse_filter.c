@@ -0,0 +1,223 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include "sparse_filter.h"
+#include "constants.h"
+#include "assertions.h"
+
+/**
+ * @brief 
+ * Maximum number of outputs computed together by `sparse_filter_real_process_block`.
+ * Sized so that the accumulators stay resident in L1 cache.
+ */
+#define SPARSE_FILTER_BLOCK_LENGTH 256
+
+SparseFilterReal *sparse_filter_real_make(const VectorReal *feedforward) {
+    assert_valid_vector(feedforward);
+
+    size_t n_taps = vector_length_generic(feedforward);
+    size_t n_nonzero = 0;
+    for (size_t i = 0; i < n_taps; i++) {
+        if (*vector_real_element(i, (VectorReal *) feedforward) != 0.0)
+            n_nonzero++;
+    }
+
+    SparseFilterReal *filter = malloc(sizeof(SparseFilterReal) + n_nonzero * sizeof(SparseTap));
+    if (filter == NULL)
+        return NULL;
+
+    filter->previous_input = vector_real_new_contiguous(n_taps);
+    if (filter->previous_input == NULL) {
+        free(filter);
+        return NULL;
+    }
+
+    filter->n_taps = n_taps;
+    filter->n_nonzero = n_nonzero;
+    size_t tap_index = 0;
+    for (size_t i = 0; i < n_taps; i++) {
+        double coefficient = *vector_real_element(i, (VectorReal *) feedforward);
+        if (coefficient != 0.0) {
+            filter->taps[tap_index].offset = i;
+            filter->taps[tap_index].coefficient = coefficient;
+            tap_index++;
+        }
+    }
+    return filter;
+}
+
+double sparse_filter_real_evaluate(double input, SparseFilterReal *filter) {
+    assert_not_null(filter);
+
+    vector_shift_generic(input, filter->previous_input);
+    const double *window = vector_contiguous_elements_generic(filter->previous_input);
+    assert_not_null(window);
+
+    double accumulate = 0.0;
+    for (size_t i = 0; i < filter->n_nonzero; i++) {
+        accumulate += filter->taps[i].coefficient * window[filter->taps[i].offset];
+    }
+    return accumulate;
+}
+
+void sparse_filter_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    SparseFilterReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input);
+    if (block_limit > SPARSE_FILTER_BLOCK_LENGTH)
+        block_limit = SPARSE_FILTER_BLOCK_LENGTH;
+
+    double accumulate[SPARSE_FILTER_BLOCK_LENGTH];
+    while (length > 0) {
+        size_t block_length = length < block_limit ? length : block_limit;
+        const double *history =
+            vector_shift_block_generic(input, block_length, filter->previous_input);
+
+        for (size_t k = 0; k < block_length; k++) {
+            accumulate[k] = 0.0;
+        }
+
+        /**
+         * @brief 
+         * Taps are the outer loop, in the same order as `sparse_filter_real_evaluate`,
+         * so the inner loop runs across outputs without reordering the per-output sums
+         */
+        for (size_t i = 0; i < filter->n_nonzero; i++) {
+            double coefficient = filter->taps[i].coefficient;
+            const double *tap_input = &history[1 + filter->taps[i].offset];
+            for (size_t k = 0; k < block_length; k++) {
+                accumulate[k] += coefficient * tap_input[k];
+            }
+        }
+
+        for (size_t k = 0; k < block_length; k++) {
+            output[k] = accumulate[k];
+        }
+
+        input += block_length;
+        output += block_length;
+        length -= block_length;
+    }
+}
+
+void sparse_filter_real_reset(SparseFilterReal *filter) {
+    assert_not_null(filter);
+
+    vector_reset_generic(filter->previous_input);
+}
+
+void sparse_filter_real_free(SparseFilterReal *filter) {
+    assert_not_null(filter);
+
+    assert_not_null(filter->previous_input);
+    vector_free_generic(filter->previous_input);
+    free(filter);
+}
+
+HalfBandDecimatorReal *half_band_decimator_real_make(size_t length, WindowFunction window) {
+    assert(length % 4 == 3);
+
+    if (window == NULL)
+        window = window_rectangular;
+
+    size_t n_folded = (length + 1) / 4;
+    HalfBandDecimatorReal *filter =
+        malloc(sizeof(HalfBandDecimatorReal) + n_folded * sizeof(double));
+    if (filter == NULL)
+        return NULL;
+
+    filter->previous_input = vector_real_new_contiguous(length);
+    if (filter->previous_input == NULL) {
+        free(filter);
+        return NULL;
+    }
+
+    filter->n_taps = length;
+    filter->n_folded = n_folded;
+    filter->phase = 0;
+
+    /**
+     * @brief 
+     * The ideal half-band response is sinc(n / 2), which is zero at every even
+     * offset from the center except the center itself.
+     */
+    size_t center = length / 2;
+    double uncorrected_dc_gain = 0;
+    for (size_t j = 0; j < n_folded; j++) {
+        size_t offset = 2 * j;
+        double distance = ((double) offset - (double) center) / 2;
+        filter->coefficients[j] = sin(M_PI * distance) / (M_PI * distance) * window(offset, length);
+        uncorrected_dc_gain += 2 * filter->coefficients[j];
+    }
+
+    /**
+     * @brief 
+     * The center coefficient stays at exactly 1/2,
+     * so the other coefficients are scaled to make up the rest of the unity DC gain
+     */
+    for (size_t j = 0; j < n_folded; j++) {
+        filter->coefficients[j] *= 0.5 / uncorrected_dc_gain;
+    }
+    return filter;
+}
+
+size_t half_band_decimator_real_process_block(
+    const double *input,
+    double *output,
+    size_t length,
+    HalfBandDecimatorReal *filter
+) {
+    assert_not_null(filter);
+    assert(length == 0 || (input != NULL && output != NULL));
+
+    size_t n_taps = filter->n_taps;
+    size_t center = n_taps / 2;
+    size_t block_limit = vector_shift_block_limit_generic(filter->previous_input);
+
+    size_t n_outputs = 0;
+    while (length > 0) {
+        size_t block_length = length < block_limit ? length : block_limit;
+        const double *history =
+            vector_shift_block_generic(input, block_length, filter->previous_input);
+
+        /**
+         * @brief 
+         * The window after shifting in input `i` of the block starts at `history[i + 1]`.
+         * Only every second window is evaluated.
+         */
+        for (size_t i = 1 - filter->phase; i < block_length; i += 2) {
+            const double *window = &history[i + 1];
+            double sum = 0.5 * window[center];
+            for (size_t j = 0; j < filter->n_folded; j++) {
+                sum += filter->coefficients[j] * (window[2 * j] + window[n_taps - 1 - 2 * j]);
+            }
+            output[n_outputs++] = sum;
+        }
+        filter->phase = (filter->phase + block_length) % 2;
+
+        input += block_length;
+        length -= block_length;
+    }
+    return n_outputs;
+}
+
+void half_band_decimator_real_reset(HalfBandDecimatorReal *filter) {
+    assert_not_null(filter);
+
+    vector_reset_generic(filter->previous_input);
+    filter->phase = 0;
+}
+
+void half_band_decimator_real_free(HalfBandDecimatorReal *filter) {
+    assert_not_null(filter);
+
+    assert_not_null(filter->previous_input);
+    vector_free_generic(filter->previous_input);
+    free(filter);
+}
@@ -17,6 +17,22 @@ double complex vector_complex_element_value(int index, const VectorComplex *buf)
 double complex vector_complex_shift(double complex element, VectorComplex *buf) {
     assert(buf != NULL);
     assert(buf->elements != NULL);
+    if (buf->capacity > buf->n_elements) {
+        double complex last_element = buf->elements[buf->last_element_index + 1 - buf->n_elements];
+        if (buf->last_element_index + 1 == buf->capacity) {
+            memmove(
+                buf->elements, 
+                &buf->elements[buf->capacity + 1 - buf->n_elements], 
+                sizeof(double complex) * (buf->n_elements - 1)
+            );
+            buf->last_element_index = buf->n_elements - 1;
+        }
+        else {
+            buf->last_element_index++;
+        }
+        buf->elements[buf->last_element_index] = element;
+        return last_element;
+    }
     buf->last_element_index = modular_add(buf->last_element_index, 1, buf->n_elements);
     double complex last_element = buf->elements[buf->last_element_index];
     buf->elements[buf->last_element_index] = element;
@@ -26,6 +42,22 @@ double complex vector_complex_shift(double complex element, VectorComplex *buf)
 double vector_real_shift(double element, VectorReal *buf) {
     assert(buf != NULL);
     assert(buf->elements != NULL);
+    if (buf->capacity > buf->n_elements) {
+        double last_element = buf->elements[buf->last_element_index + 1 - buf->n_elements];
+        if (buf->last_element_index + 1 == buf->capacity) {
+            memmove(
+                buf->elements, 
+                &buf->elements[buf->capacity + 1 - buf->n_elements], 
+                sizeof(double) * (buf->n_elements - 1)
+            );
+            buf->last_element_index = buf->n_elements - 1;
+        }
+        else {
+            buf->last_element_index++;
+        }
+        buf->elements[buf->last_element_index] = element;
+        return last_element;
+    }
     buf->last_element_index = modular_add(buf->last_element_index, 1, buf->n_elements);
     double last_element = buf->elements[buf->last_element_index];
     buf->elements[buf->last_element_index] = element;
@@ -33,10 +65,14 @@ double vector_real_shift(double element, VectorReal *buf) {
 }
 
 double complex *vector_complex_element(int index, VectorComplex *buf) {
+    size_t offset = buf->capacity > buf->n_elements ? 
+        buf->last_element_index + 1 - buf->n_elements : 
+        0;
     return &buf->elements[
+        offset + 
         modular_add( 
             index * (buf->is_reversed ? -1 : 1), 
-            buf->last_element_index + ! buf->is_reversed,
+            buf->last_element_index - offset + ! buf->is_reversed,
             buf->n_elements)
     ];
 }
@@ -46,10 +82,14 @@ double complex vector_complex_element_value(int index, const VectorComplex *buf)
 }
 
 double *vector_real_element(int index, VectorReal *buf) {
+    size_t offset = buf->capacity > buf->n_elements ? 
+        buf->last_element_index + 1 - buf->n_elements : 
+        0;
     return &buf->elements[
+        offset + 
         modular_add( 
             index * (buf->is_reversed ? -1 : 1), 
-            buf->last_element_index + ! buf->is_reversed,
+            buf->last_element_index - offset + ! buf->is_reversed,
             buf->n_elements)
     ];
 }
@@ -75,6 +115,17 @@ double vector_real_interpolated_element(double index, VectorReal const *buf) {
 double vector_real_dot(const VectorReal *a, const VectorReal *b) {
     assert(vector_length_generic(a) == vector_length_generic(b));
     double sum = 0;
+
+    const double *a_elements = vector_contiguous_elements_generic(a);
+    const double *b_elements = vector_contiguous_elements_generic(b);
+    if (a_elements != NULL && b_elements != NULL) {
+        size_t length = vector_length_generic(a);
+        for (size_t i = 0; i < length; i++) {
+            sum += a_elements[i] * b_elements[i];
+        }
+        return sum;
+    }
+
     for (size_t i = 0; i < vector_length_generic(a); i++) {
         sum += vector_element_value_generic(i, a) * vector_element_value_generic(i, b);
     }
@@ -84,6 +135,24 @@ double vector_real_dot(const VectorReal *a, const VectorReal *b) {
 double complex vector_complex_dot(const VectorComplex *a, const VectorComplex *b) {
     assert(vector_length_generic(a) == vector_length_generic(b));
     double complex sum = 0;
+
+    const double complex *a_elements = vector_contiguous_elements_generic(a);
+    const double complex *b_elements = vector_contiguous_elements_generic(b);
+    if (a_elements != NULL && b_elements != NULL) {
+        size_t length = vector_length_generic(a);
+        double sum_real = 0;
+        double sum_imag = 0;
+        for (size_t i = 0; i < length; i++) {
+            sum_real += 
+                creal(a_elements[i]) * creal(b_elements[i]) - 
+                cimag(a_elements[i]) * cimag(b_elements[i]);
+            sum_imag += 
+                creal(a_elements[i]) * cimag(b_elements[i]) + 
+                cimag(a_elements[i]) * creal(b_elements[i]);
+        }
+        return CMPLX(sum_real, sum_imag);
+    }
+
     for (size_t i = 0; i < vector_length_generic(a); i++) {
         sum += vector_element_value_generic(i, a) * vector_element_value_generic(i, b);
     }
@@ -127,11 +196,68 @@ VectorComplex *vector_complex_new(size_t size) {
         return NULL;
 
     circbuf->n_elements = size;
+    circbuf->capacity = size;
+
+    vector_reset_generic(circbuf);
+    return circbuf;
+}
+
+VectorComplex *vector_complex_new_contiguous(size_t size) {
+    assert(size > 0);
+    size_t headroom = size > VECTOR_CONTIGUOUS_MINIMUM_HEADROOM ? 
+        size : 
+        VECTOR_CONTIGUOUS_MINIMUM_HEADROOM;
+    VectorComplex *circbuf = malloc(
+        sizeof(VectorComplex) + sizeof(double complex) * (size + headroom));
+    if (circbuf == NULL)
+        return NULL;
+
+    circbuf->n_elements = size;
+    circbuf->capacity = size + headroom;
 
     vector_reset_generic(circbuf);
     return circbuf;
 }
 
+double complex *vector_complex_contiguous_elements(const VectorComplex *buf) {
+    if (buf->is_reversed)
+        return NULL;
+    if (buf->capacity > buf->n_elements)
+        return (double complex *) &buf->elements[buf->last_element_index + 1 - buf->n_elements];
+    if (buf->last_element_index + 1 == buf->n_elements)
+        return (double complex *) buf->elements;
+    return NULL;
+}
+
+const double complex *vector_complex_shift_block(const double complex elements[], size_t length, VectorComplex *buf) {
+    assert_valid_vector(buf);
+    assert(! buf->is_reversed);
+    assert(buf->capacity > buf->n_elements);
+    assert(length <= vector_complex_shift_block_limit(buf));
+
+    size_t first_element_index = buf->last_element_index + 1 - buf->n_elements;
+    if (buf->last_element_index + 1 + length > buf->capacity) {
+        memmove(
+            buf->elements, 
+            &buf->elements[first_element_index], 
+            sizeof(double complex) * buf->n_elements
+        );
+        first_element_index = 0;
+        buf->last_element_index = buf->n_elements - 1;
+    }
+    memcpy(
+        &buf->elements[buf->last_element_index + 1], 
+        elements, 
+        sizeof(double complex) * length
+    );
+    buf->last_element_index += length;
+    return &buf->elements[first_element_index];
+}
+
+size_t vector_complex_shift_block_limit(const VectorComplex *buf) {
+    return buf->capacity - buf->n_elements;
+}
+
 VectorReal *vector_real_new(size_t size) {
     VectorReal *circbuf = malloc(
         sizeof(VectorReal) + sizeof(double) * size);
@@ -139,11 +265,68 @@ VectorReal *vector_real_new(size_t size) {
         return NULL;
 
     circbuf->n_elements = size;
+    circbuf->capacity = size;
 
     vector_reset_generic(circbuf);
     return circbuf;
 }
 
+VectorReal *vector_real_new_contiguous(size_t size) {
+    assert(size > 0);
+    size_t headroom = size > VECTOR_CONTIGUOUS_MINIMUM_HEADROOM ? 
+        size : 
+        VECTOR_CONTIGUOUS_MINIMUM_HEADROOM;
+    VectorReal *circbuf = malloc(
+        sizeof(VectorReal) + sizeof(double) * (size + headroom));
+    if (circbuf == NULL)
+        return NULL;
+
+    circbuf->n_elements = size;
+    circbuf->capacity = size + headroom;
+
+    vector_reset_generic(circbuf);
+    return circbuf;
+}
+
+double *vector_real_contiguous_elements(const VectorReal *buf) {
+    if (buf->is_reversed)
+        return NULL;
+    if (buf->capacity > buf->n_elements)
+        return (double *) &buf->elements[buf->last_element_index + 1 - buf->n_elements];
+    if (buf->last_element_index + 1 == buf->n_elements)
+        return (double *) buf->elements;
+    return NULL;
+}
+
+const double *vector_real_shift_block(const double elements[], size_t length, VectorReal *buf) {
+    assert_valid_vector(buf);
+    assert(! buf->is_reversed);
+    assert(buf->capacity > buf->n_elements);
+    assert(length <= vector_real_shift_block_limit(buf));
+
+    size_t first_element_index = buf->last_element_index + 1 - buf->n_elements;
+    if (buf->last_element_index + 1 + length > buf->capacity) {
+        memmove(
+            buf->elements, 
+            &buf->elements[first_element_index], 
+            sizeof(double) * buf->n_elements
+        );
+        first_element_index = 0;
+        buf->last_element_index = buf->n_elements - 1;
+    }
+    memcpy(
+        &buf->elements[buf->last_element_index + 1], 
+        elements, 
+        sizeof(double) * length
+    );
+    buf->last_element_index += length;
+    return &buf->elements[first_element_index];
+}
+
+size_t vector_real_shift_block_limit(const VectorReal *buf) {
+    return buf->capacity - buf->n_elements;
+}
+
 VectorComplex *vector_complex_from_array(size_t size, const double complex elements[]) {
     VectorComplex *vector = vector_complex_new(size);
     if (vector == NULL) {
@@ -172,29 +355,43 @@ VectorReal *vector_real_from_array(size_t size, const double elements[]) {
 
 VectorComplex *vector_complex_duplicate(const VectorComplex *vector) {
     size_t vector_length = vector_length_generic(vector);
-    VectorComplex *new_vector = vector_complex_new(vector_length);
+    VectorComplex *new_vector = vector->capacity > vector->n_elements ? 
+        vector_complex_new_contiguous(vector_length) : 
+        vector_complex_new(vector_length);
     if (new_vector == NULL) {
         return NULL;
     }
-    memcpy(
-        new_vector->elements, 
-        vector->elements, 
-        sizeof(double complex) * vector_length
-    );
+
+    /**
+     * @brief 
+     * Elements are copied in index order, so that the duplicate 
+     * is stored contiguously regardless of the layout of the original.
+     */
+    for (size_t i = 0; i < vector_length; i++) {
+        new_vector->elements[i] = vector_element_value_generic(i, vector);
+    }
+    new_vector->last_element_index = vector_length - 1;
     return new_vector;
 }
 
 VectorReal *vector_real_duplicate(const VectorReal *vector) {
     size_t vector_length = vector_length_generic(vector);
-    VectorReal *new_vector = vector_real_new(vector_length);
+    VectorReal *new_vector = vector->capacity > vector->n_elements ? 
+        vector_real_new_contiguous(vector_length) : 
+        vector_real_new(vector_length);
     if (new_vector == NULL) {
         return NULL;
     }
-    memcpy(
-        new_vector->elements, 
-        vector->elements, 
-        sizeof(double) * vector_length
-    );
+
+    /**
+     * @brief 
+     * Elements are copied in index order, so that the duplicate 
+     * is stored contiguously regardless of the layout of the original.
+     */
+    for (size_t i = 0; i < vector_length; i++) {
+        new_vector->elements[i] = vector_element_value_generic(i, vector);
+    }
+    new_vector->last_element_index = vector_length - 1;
     return new_vector;
 }
 
@@ -221,7 +418,7 @@ void vector_complex_reset(VectorComplex *buf) {
     for (size_t ii = 0; ii < buf->n_elements; ii++) {
         buf->elements[ii] = 0.0;
     }
-    buf->last_element_index = 0;
+    buf->last_element_index = buf->capacity > buf->n_elements ? buf->n_elements - 1 : 0;
     buf->is_reversed = false;
 }
 
@@ -231,7 +428,7 @@ void vector_real_reset(VectorReal *buf) {
     for (size_t ii = 0; ii < buf->n_elements; ii++) {
         buf->elements[ii] = 0.0;
     }
-    buf->last_element_index = 0;
+    buf->last_element_index = buf->capacity > buf->n_elements ? buf->n_elements - 1 : 0;
     buf->is_reversed = false;
 }
 
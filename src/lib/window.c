@@ -7,22 +7,38 @@
  * @brief 
  * Evaluates a generalized Hann window function
  * @param element_index Window element index
- * @param window_size Size of window
+ * @param period Number of elements in one period of the cosine
  * @param a0 Scaling constant
  * @return Window value 
  */
-double generalized_hann_function(size_t element_index, size_t window_size, double a0);
+double generalized_hann_function(size_t element_index, size_t period, double a0);
 
 double window_rectangular(size_t element_index, size_t window_size) {
     assert(element_index < window_size);
     return 1;
 }
 
-double generalized_hann_function(size_t element_index, size_t window_size, double a0) {
-    assert(element_index < window_size);
-    return a0 - (1 - a0) * cos(2 * M_PI * element_index / window_size);
+double generalized_hann_function(size_t element_index, size_t period, double a0) {
+    return a0 - (1 - a0) * cos(2 * M_PI * element_index / period);
 }
 
 double window_hamming(size_t element_index, size_t window_size) {
+    assert(element_index < window_size);
     return generalized_hann_function(element_index, window_size, 25.0/46.0);
-}
\ No newline at end of file
+}
+
+double window_hamming_symmetric(size_t element_index, size_t window_size) {
+    assert(element_index < window_size);
+    if (window_size == 1)
+        return 1;
+
+    /**
+     * @brief 
+     * The second half is evaluated at its mirror index, 
+     * so that rounding cannot make mirrored elements differ
+     */
+    size_t mirror_index = window_size - 1 - element_index;
+    if (mirror_index < element_index)
+        element_index = mirror_index;
+    return generalized_hann_function(element_index, window_size - 1, 25.0/46.0);
+}
@@ -0,0 +1,121 @@
+#include <math.h>
+#include <complex.h>
+#include <stdlib.h>
+#include "biquad.h"
+#include "test.h"
+#include "constants.h"
+
+#define TEST_SIGNAL_LENGTH 20000
+
+const double half_power_gain = 0.70710678118654752;
+
+void test_butterworth();
+void test_chebyshev();
+void test_block();
+double measure_gain(double frequency, BiquadCascadeReal *filter);
+
+int main() {
+    test_butterworth();
+    test_chebyshev();
+    test_block();
+    return 0;
+}
+
+void test_butterworth() {
+    BiquadCascadeReal *low_pass = biquad_make_butterworth(5, 0.1, LOW_PASS);
+    munit_assert_not_null(low_pass);
+    munit_assert_size(low_pass->n_sections, ==, 3);
+    munit_assert_double_equal(measure_gain(0.0, low_pass), 1.0, 6);
+    munit_assert_double_equal(measure_gain(0.1, low_pass), half_power_gain, 6);
+    munit_assert_double(measure_gain(0.3, low_pass), <, 1e-3);
+    biquad_cascade_real_free(low_pass);
+
+    BiquadCascadeReal *high_pass = biquad_make_butterworth(4, 0.2, HIGH_PASS);
+    munit_assert_double_equal(measure_gain(0.2, high_pass), half_power_gain, 6);
+    munit_assert_double_equal(measure_gain(0.45, high_pass), 1.0, 2);
+    munit_assert_double(measure_gain(0.02, high_pass), <, 1e-3);
+    biquad_cascade_real_free(high_pass);
+
+    BiquadCascadeReal *band_pass = biquad_make_butterworth_band_pass(4, 0.1, 0.2);
+    munit_assert_size(band_pass->n_sections, ==, 4);
+    munit_assert_double_equal(measure_gain(0.1, band_pass), half_power_gain, 6);
+    munit_assert_double_equal(measure_gain(0.2, band_pass), half_power_gain, 6);
+    munit_assert_double(measure_gain(0.02, band_pass), <, 1e-3);
+    munit_assert_double(measure_gain(0.4, band_pass), <, 1e-3);
+    biquad_cascade_real_free(band_pass);
+}
+
+void test_chebyshev() {
+    double ripple_db = 1.0;
+    double edge_gain = pow(10.0, -ripple_db / 20.0);
+
+    BiquadCascadeReal *low_pass = biquad_make_chebyshev(4, ripple_db, 0.1, LOW_PASS);
+    munit_assert_double_equal(measure_gain(0.0, low_pass), edge_gain, 6);
+    munit_assert_double_equal(measure_gain(0.1, low_pass), edge_gain, 6);
+    biquad_cascade_real_free(low_pass);
+
+    BiquadCascadeReal *high_pass = biquad_make_chebyshev(5, ripple_db, 0.3, HIGH_PASS);
+    munit_assert_double_equal(measure_gain(0.5, high_pass), 1.0, 6);
+    munit_assert_double_equal(measure_gain(0.3, high_pass), edge_gain, 6);
+    biquad_cascade_real_free(high_pass);
+
+    BiquadCascadeReal *band_pass = biquad_make_chebyshev_band_pass(3, ripple_db, 0.15, 0.25);
+    munit_assert_double_equal(measure_gain(0.15, band_pass), edge_gain, 6);
+    munit_assert_double_equal(measure_gain(0.25, band_pass), edge_gain, 6);
+    biquad_cascade_real_free(band_pass);
+}
+
+void test_block() {
+    BiquadCascadeReal *sample_filter = biquad_make_chebyshev(6, 0.5, 0.05, LOW_PASS);
+    BiquadCascadeReal *block_filter = biquad_make_chebyshev(6, 0.5, 0.05, LOW_PASS);
+
+    double input[TEST_SIGNAL_LENGTH];
+    double output[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * 0.01 * i) + cos(2 * M_PI * 0.3 * i);
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        biquad_cascade_real_process_block(
+            &input[block.start], &output[block.start], block.length, block_filter
+        );
+    }
+
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        munit_assert_double(
+            output[i], ==, biquad_cascade_real_evaluate(input[i], sample_filter)
+        );
+    }
+
+    biquad_cascade_real_free(sample_filter);
+    biquad_cascade_real_free(block_filter);
+}
+
+/**
+ * @brief 
+ * Measures the steady-state gain of a filter by filtering a complex exponential
+ * as separate in-phase and quadrature signals
+ */
+double measure_gain(double frequency, BiquadCascadeReal *filter) {
+    BiquadCoefficients *coefficients = malloc(sizeof(BiquadCoefficients) * filter->n_sections);
+    for (size_t i = 0; i < filter->n_sections; i++) {
+        coefficients[i] = filter->sections[i].coefficients;
+    }
+    BiquadCascadeReal *quadrature_filter = 
+        biquad_cascade_real_make(filter->n_sections, coefficients);
+    free(coefficients);
+    biquad_cascade_real_reset(filter);
+
+    double complex output = 0;
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double complex input = cexp(I * 2 * M_PI * frequency * i);
+        output = CMPLX(
+            biquad_cascade_real_evaluate(creal(input), filter),
+            biquad_cascade_real_evaluate(cimag(input), quadrature_filter)
+        );
+    }
+
+    biquad_cascade_real_reset(filter);
+    biquad_cascade_real_free(quadrature_filter);
+    return cabs(output);
+}
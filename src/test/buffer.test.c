@@ -2,9 +2,11 @@
 #include "vector.h"
 
 void test_indexing();
+void test_contiguous();
 
 int main() {
     test_indexing();
+    test_contiguous();
     return 0;
 }
 
@@ -27,4 +29,58 @@ void test_indexing() {
     assert_complex_equal(*vector_complex_element(1.0, test_buf), 3.0, 5);
 
     assert_complex_equal(vector_complex_dot(test_buf, test_buf), 30.0, 5);
-}
\ No newline at end of file
+}
+
+void test_contiguous() {
+    VectorReal *ring = vector_real_new(7);
+    VectorReal *contiguous = vector_real_new_contiguous(7);
+    VectorReal *coefficients = vector_real_new(7);
+    for (int i = 0; i < 7; i++) {
+        *vector_real_element(i, coefficients) = i + 1;
+    }
+
+    for (int i = 0; i < 40; i++) {
+        munit_assert_double_equal(
+            vector_real_shift(i, contiguous), 
+            vector_real_shift(i, ring), 
+            10
+        );
+        munit_assert_not_null(vector_real_contiguous_elements(contiguous));
+        for (int j = -7; j < 7; j++) {
+            munit_assert_double_equal(
+                *vector_real_element(j, contiguous), 
+                *vector_real_element(j, ring), 
+                10
+            );
+        }
+        munit_assert_double_equal(
+            vector_real_dot(coefficients, contiguous), 
+            vector_real_dot(coefficients, ring), 
+            10
+        );
+    }
+
+    VectorReal *duplicate = vector_real_duplicate(ring);
+    munit_assert_not_null(vector_real_contiguous_elements(duplicate));
+    for (int j = 0; j < 7; j++) {
+        munit_assert_double_equal(
+            *vector_real_element(j, duplicate), 
+            *vector_real_element(j, ring), 
+            10
+        );
+    }
+
+    vector_real_reverse(contiguous);
+    vector_real_reverse(ring);
+    munit_assert_null(vector_real_contiguous_elements(contiguous));
+    munit_assert_double_equal(
+        *vector_real_element(0, contiguous), 
+        *vector_real_element(0, ring), 
+        10
+    );
+
+    vector_real_free(duplicate);
+    vector_real_free(coefficients);
+    vector_real_free(contiguous);
+    vector_real_free(ring);
+}
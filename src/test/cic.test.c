@@ -0,0 +1,200 @@
+#include <math.h>
+#include <complex.h>
+#include "cic.h"
+#include "test.h"
+#include "window.h"
+#include "constants.h"
+
+#define TEST_SIGNAL_LENGTH 6000
+
+void test_decimator(size_t order, size_t decimation, size_t differential_delay);
+void test_interpolator(size_t order, size_t interpolation, size_t differential_delay);
+void test_wraparound();
+void test_compensator();
+
+/**
+ * @brief 
+ * Calculates the impulse response of a CIC filter,
+ * as `order` cascaded moving sums of `rate_change * differential_delay` inputs
+ * @param response Impulse response. Must have room for `order * (rate_change * differential_delay - 1) + 1` values.
+ * @return Length of the impulse response
+ */
+size_t reference_response(size_t order, size_t rate_change, size_t differential_delay, int64_t *response);
+
+int main() {
+    test_decimator(3, 8, 1);
+    test_decimator(5, 4, 2);
+    test_interpolator(3, 8, 1);
+    test_interpolator(4, 5, 2);
+    test_wraparound();
+    test_compensator();
+    return 0;
+}
+
+void test_decimator(size_t order, size_t decimation, size_t differential_delay) {
+    CicDecimatorReal *whole = cic_decimator_real_make(order, decimation, differential_delay, 16, false);
+    CicDecimatorReal *split = cic_decimator_real_make(order, decimation, differential_delay, 16, false);
+    munit_assert_not_null(whole);
+    munit_assert_not_null(split);
+
+    static int32_t input[TEST_SIGNAL_LENGTH];
+    static double whole_output[TEST_SIGNAL_LENGTH];
+    static double split_output[TEST_SIGNAL_LENGTH];
+    static int64_t response[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = (int32_t) (30000 * sin(0.01 * i) + (i * 7919) % 2001 - 1000);
+    }
+
+    size_t n_outputs = cic_decimator_real_process_block(input, whole_output, TEST_SIGNAL_LENGTH, whole);
+    munit_assert_size(n_outputs, ==, TEST_SIGNAL_LENGTH / decimation);
+
+    size_t n_split_outputs = 0;
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        n_split_outputs += cic_decimator_real_process_block(
+            &input[block.start], &split_output[n_split_outputs], block.length, split
+        );
+    }
+    munit_assert_size(n_split_outputs, ==, n_outputs);
+
+    /**
+     * @brief 
+     * Output n is the output of the equivalent full-rate filter for input (n + 1) R - 1
+     */
+    size_t n_response = reference_response(order, decimation, differential_delay, response);
+    for (size_t n = 0; n < n_outputs; n++) {
+        size_t index = (n + 1) * decimation - 1;
+        int64_t expected = 0;
+        for (size_t j = 0; j < n_response && j <= index; j++) {
+            expected += response[j] * input[index - j];
+        }
+        munit_assert_double(whole_output[n], ==, (double) expected);
+        munit_assert_double(split_output[n], ==, (double) expected);
+    }
+
+    cic_decimator_real_reset(whole);
+    munit_assert_size(cic_decimator_real_process_block(input, split_output, 100, whole), ==, 100 / decimation);
+    for (size_t n = 0; n < 100 / decimation; n++) {
+        munit_assert_double(split_output[n], ==, whole_output[n]);
+    }
+
+    cic_decimator_real_free(whole);
+    cic_decimator_real_free(split);
+}
+
+void test_interpolator(size_t order, size_t interpolation, size_t differential_delay) {
+    const size_t length = 500;
+    CicInterpolatorReal *filter = cic_interpolator_real_make(order, interpolation, differential_delay, 16, false);
+    CicInterpolatorReal *compensated = cic_interpolator_real_make(order, interpolation, differential_delay, 16, true);
+    munit_assert_not_null(filter);
+    munit_assert_not_null(compensated);
+
+    static int32_t input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    static int64_t response[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < length; i++) {
+        input[i] = (int32_t) ((i * 7919) % 65535) - 32767;
+    }
+
+    size_t n_outputs = cic_interpolator_real_process_block(input, output, length, filter);
+    munit_assert_size(n_outputs, ==, length * interpolation);
+
+    /**
+     * @brief 
+     * The equivalent full-rate filter is applied to the zero-stuffed input
+     */
+    size_t n_response = reference_response(order, interpolation, differential_delay, response);
+    for (size_t m = 0; m < n_outputs; m++) {
+        int64_t expected = 0;
+        for (size_t j = m % interpolation; j < n_response && j <= m; j += interpolation) {
+            expected += response[j] * input[(m - j) / interpolation];
+        }
+        munit_assert_double(output[m], ==, (double) expected);
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        input[i] = -1234;
+    }
+    n_outputs = cic_interpolator_real_process_block(input, output, length, compensated);
+    for (size_t m = n_response; m < n_outputs; m++) {
+        munit_assert_double_equal(output[m], -1234.0, 9);
+    }
+
+    cic_interpolator_real_free(filter);
+    cic_interpolator_real_free(compensated);
+}
+
+void test_wraparound() {
+    /**
+     * @brief 
+     * The last integrator of a fifth-order filter grows as the fifth power of time for a constant input,
+     * and wraps around many times over this signal
+     */
+    const int32_t value = 32767;
+    const size_t decimation = 64;
+    CicDecimatorReal *filter = cic_decimator_real_make(5, decimation, 1, 16, true);
+    munit_assert_not_null(filter);
+
+    static int32_t input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = value;
+    }
+
+    for (size_t block = 0; block < 200; block++) {
+        size_t n_outputs = cic_decimator_real_process_block(input, output, TEST_SIGNAL_LENGTH - 16, filter);
+        for (size_t n = block == 0 ? 5 : 0; n < n_outputs; n++) {
+            munit_assert_double(output[n], ==, value);
+        }
+    }
+
+    cic_decimator_real_free(filter);
+}
+
+void test_compensator() {
+    const size_t order = 4;
+    const size_t decimation = 16;
+    const size_t n_points = 1024;
+    DigitalFilterReal *compensator = cic_make_compensator(order, decimation, 1, 0.2, 31, window_hamming_symmetric);
+    munit_assert_not_null(compensator);
+
+    FrequencyResponsePlan *plan = filter_make_frequency_response_plan(n_points);
+    munit_assert_not_null(plan);
+    static double complex response[1024];
+    filter_frequency_response_real(compensator, plan, response, NULL);
+    munit_assert_double_equal(cabs(response[0]), 1.0, 9);
+
+    /**
+     * @brief 
+     * Without compensation the CIC droops by about 1.1 dB at a quarter of the output Nyquist band.
+     * The compensated pass band is flat to a small fraction of that.
+     */
+    for (size_t k = 1; k < n_points * 0.125; k++) {
+        double frequency = (double) k / n_points;
+        double cic_response = pow(
+            sin(M_PI * frequency) / (decimation * sin(M_PI * frequency / decimation)), order
+        );
+        munit_assert_double_equal(cabs(response[k]) * cic_response, 1.0, 2);
+    }
+
+    filter_free_frequency_response_plan(plan);
+    filter_free_digital_filter_real(compensator);
+}
+
+size_t reference_response(size_t order, size_t rate_change, size_t differential_delay, int64_t *response) {
+    size_t boxcar_length = rate_change * differential_delay;
+    size_t length = 1;
+    response[0] = 1;
+    for (size_t stage = 0; stage < order; stage++) {
+        size_t new_length = length + boxcar_length - 1;
+        for (size_t i = new_length; i-- > 0;) {
+            int64_t sum = 0;
+            for (size_t j = 0; j < boxcar_length && j <= i; j++) {
+                if (i - j < length)
+                    sum += response[i - j];
+            }
+            response[i] = sum;
+        }
+        length = new_length;
+    }
+    return length;
+}
@@ -0,0 +1,61 @@
+#include <math.h>
+#include <complex.h>
+#include "ewma.h"
+#include "filter.h"
+#include "test.h"
+
+#define TEST_SIGNAL_LENGTH 5000
+
+void test_ewma(double cutoff_frequency);
+
+int main() {
+    test_ewma(0.001);
+    test_ewma(0.05);
+    test_ewma(0.4);
+    return 0;
+}
+
+void test_ewma(double cutoff_frequency) {
+    DigitalFilterComplex *reference = filter_make_first_order_iir(cutoff_frequency);
+    munit_assert_not_null(reference);
+    EwmaReal real_ewma = ewma_real_make_first_order_iir(cutoff_frequency);
+    EwmaReal real_block_ewma = ewma_real_make(ewma_alpha_from_cutoff(cutoff_frequency));
+    EwmaComplex complex_ewma = ewma_complex_make_first_order_iir(cutoff_frequency);
+    EwmaComplex complex_block_ewma = complex_ewma;
+    munit_assert_double(real_ewma.alpha, ==, creal(*vector_complex_element(0, reference->feedforward)));
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    static double complex complex_input[TEST_SIGNAL_LENGTH];
+    static double complex complex_output[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(0.01 * i) + 0.1 * (double) ((i * 7919) % 17);
+        complex_input[i] = CMPLX(input[i], cos(0.02 * i));
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        ewma_real_process_block(&input[block.start], &output[block.start], block.length, &real_block_ewma);
+        ewma_complex_process_block(
+            &complex_input[block.start], &complex_output[block.start], block.length, &complex_block_ewma
+        );
+    }
+
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double value = ewma_real_evaluate(input[i], &real_ewma);
+        double complex complex_value = ewma_complex_evaluate(complex_input[i], &complex_ewma);
+        double complex expected = filter_evaluate_digital_filter_complex(complex_input[i], reference);
+
+        munit_assert_double(value, ==, output[i]);
+        munit_assert_double(creal(complex_value), ==, creal(complex_output[i]));
+        munit_assert_double(cimag(complex_value), ==, cimag(complex_output[i]));
+        munit_assert_double(creal(complex_value), ==, value);
+        assert_complex_equal(complex_value, expected, 9);
+    }
+
+    ewma_real_reset(&real_ewma);
+    munit_assert_double(ewma_real_evaluate(input[0], &real_ewma), ==, output[0]);
+    ewma_complex_reset(&complex_ewma);
+    munit_assert_double(cimag(ewma_complex_evaluate(complex_input[0], &complex_ewma)), ==, cimag(complex_output[0]));
+
+    filter_free_digital_filter_complex(reference);
+}
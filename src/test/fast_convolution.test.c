@@ -0,0 +1,107 @@
+#include <math.h>
+#include <stdlib.h>
+#include "fast_convolution.h"
+#include "filter.h"
+#include "test.h"
+#include "window.h"
+
+#define TEST_SIGNAL_LENGTH 20000
+
+void test_overlap_save(size_t length, const size_t block_lengths[], size_t n_block_lengths);
+void test_partitioned(
+    size_t length, 
+    size_t partition_length, 
+    const size_t block_lengths[], 
+    size_t n_block_lengths
+);
+void fill_test_signal(double input[]);
+
+int main() {
+    const size_t block_lengths[] = {1, 5000, 37, 3, 4096, 999};
+    test_overlap_save(1001, block_lengths, 6);
+    test_overlap_save(15, block_lengths, 6);
+
+    const size_t single_block_length[] = {TEST_SIGNAL_LENGTH};
+    test_overlap_save(4001, single_block_length, 1);
+
+    test_partitioned(4001, 128, block_lengths, 6);
+    test_partitioned(100, 128, block_lengths, 6);
+    test_partitioned(256, 64, single_block_length, 1);
+    return 0;
+}
+
+void test_overlap_save(size_t length, const size_t block_lengths[], size_t n_block_lengths) {
+    DigitalFilterReal *direct = filter_make_sinc(0.05, length, LOW_PASS, window_hamming);
+    munit_assert_not_null(direct);
+    FastConvolutionReal *fast = fast_convolution_real_make(direct->feedforward);
+    munit_assert_not_null(fast);
+    munit_assert_size(fast_convolution_real_block_length(fast), >=, length);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    fill_test_signal(input);
+
+    size_t processed = 0;
+    for (size_t i = 0; processed < TEST_SIGNAL_LENGTH; i++) {
+        size_t block_length = block_lengths[i % n_block_lengths];
+        if (block_length > TEST_SIGNAL_LENGTH - processed)
+            block_length = TEST_SIGNAL_LENGTH - processed;
+        fast_convolution_real_process_block(
+            &input[processed], &output[processed], block_length, fast
+        );
+        processed += block_length;
+    }
+
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        munit_assert_double_equal(
+            output[i], filter_evaluate_digital_filter_real(input[i], direct), 9
+        );
+    }
+
+    fast_convolution_real_free(fast);
+    filter_free_digital_filter_real(direct);
+}
+
+void test_partitioned(
+    size_t length, 
+    size_t partition_length, 
+    const size_t block_lengths[], 
+    size_t n_block_lengths
+) {
+    DigitalFilterReal *direct = filter_make_sinc(0.05, length | 1, LOW_PASS, window_hamming);
+    munit_assert_not_null(direct);
+    PartitionedConvolutionReal *partitioned = 
+        partitioned_convolution_real_make(direct->feedforward, partition_length);
+    munit_assert_not_null(partitioned);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    fill_test_signal(input);
+
+    size_t processed = 0;
+    for (size_t i = 0; processed < TEST_SIGNAL_LENGTH; i++) {
+        size_t block_length = block_lengths[i % n_block_lengths];
+        if (block_length > TEST_SIGNAL_LENGTH - processed)
+            block_length = TEST_SIGNAL_LENGTH - processed;
+        partitioned_convolution_real_process_block(
+            &input[processed], &output[processed], block_length, partitioned
+        );
+        processed += block_length;
+    }
+
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        munit_assert_double_equal(
+            output[i], filter_evaluate_digital_filter_real(input[i], direct), 9
+        );
+    }
+
+    partitioned_convolution_real_free(partitioned);
+    filter_free_digital_filter_real(direct);
+}
+
+void fill_test_signal(double input[]) {
+    srand(1);
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = (double) rand() / RAND_MAX - 0.5 + sin(0.01 * i);
+    }
+}
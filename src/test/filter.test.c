@@ -6,10 +6,25 @@
 #include "window.h"
 #include "constants.h"
 
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
+
 #define TEST_SIGNAL_LENGTH 10000
 
+QUICKWAVE_DEFINE_FIR_REAL(FirReal31, 31)
+
 void test_iir();
 void test_sinc();
+void test_block();
+void test_decimator();
+void test_symmetry();
+void test_filter_bank(DigitalFilterReal *reference);
+void test_mixed();
+void test_fixed_length();
+void test_design_cache();
+int make_cached_filters(void *first_filter);
+void test_frequency_response(size_t n_points);
 int test_filter(
     char *output_filename, 
     double input[], 
@@ -20,10 +35,31 @@ int test_filter(
 int main() {
     test_iir();
     test_sinc();
+    test_block();
+    test_decimator();
+    test_symmetry();
+
+    DigitalFilterReal *sinc_filter = filter_make_sinc(0.1, 31, LOW_PASS, window_hamming_symmetric);
+    test_filter_bank(sinc_filter);
+    filter_free_digital_filter_real(sinc_filter);
+
+    VectorReal *ramp = vector_real_new(20);
+    for (int i = 0; i < 20; i++) {
+        *vector_real_element(i, ramp) = i / 190.0;
+    }
+    DigitalFilterReal *ramp_filter = filter_make_digital_filter_real(ramp, NULL);
+    test_filter_bank(ramp_filter);
+    filter_free_digital_filter_real(ramp_filter);
+    vector_real_free(ramp);
+
+    test_mixed();
+    test_fixed_length();
+    test_design_cache();
+    test_frequency_response(1024);
+    test_frequency_response(16);
     return 0;
 }
 
-
 void test_iir() {
     DigitalFilterComplex *iir = filter_make_first_order_iir(0.01);
     munit_assert_not_null(iir);
@@ -60,6 +96,370 @@ void test_sinc() {
     filter_free_digital_filter_real(sinc_filter);
 }
 
+void test_block() {
+    DigitalFilterReal *sample_filter = filter_make_sinc(0.1, 301, LOW_PASS, window_hamming_symmetric);
+    DigitalFilterReal *block_filter = filter_make_sinc(0.1, 301, LOW_PASS, window_hamming_symmetric);
+    DigitalFilterComplex *sample_iir = filter_make_first_order_iir(0.05);
+    DigitalFilterComplex *block_iir = filter_make_first_order_iir(0.05);
+
+    double input[TEST_SIGNAL_LENGTH];
+    double output[TEST_SIGNAL_LENGTH];
+    double complex complex_input[TEST_SIGNAL_LENGTH];
+    double complex complex_output[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * 0.02 * i) + cos(2 * M_PI * 0.3 * i);
+        complex_input[i] = cexp(I * 2 * M_PI * 0.01 * i) + 0.5 * cexp(I * 2 * M_PI * 0.4 * i);
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        filter_process_block_real(&input[block.start], &output[block.start], block.length, block_filter);
+        filter_process_block_complex(
+            &complex_input[block.start], &complex_output[block.start], block.length, block_iir
+        );
+    }
+
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        munit_assert_double(
+            output[i], ==, filter_evaluate_digital_filter_real(input[i], sample_filter)
+        );
+        double complex expected = filter_evaluate_digital_filter_complex(complex_input[i], sample_iir);
+        munit_assert_double(creal(complex_output[i]), ==, creal(expected));
+        munit_assert_double(cimag(complex_output[i]), ==, cimag(expected));
+    }
+
+    filter_free_digital_filter_real(sample_filter);
+    filter_free_digital_filter_real(block_filter);
+    filter_free_digital_filter_complex(sample_iir);
+    filter_free_digital_filter_complex(block_iir);
+}
+
+void test_decimator() {
+    const size_t decimation = 16;
+    DigitalFilterReal *reference = filter_make_sinc(0.5 / decimation, 127, LOW_PASS, window_hamming_symmetric);
+    DecimatorReal *decimator = filter_make_decimator(reference->feedforward, decimation);
+    munit_assert_not_null(decimator);
+
+    double input[TEST_SIGNAL_LENGTH];
+    double output[TEST_SIGNAL_LENGTH / 16 + 1];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * 0.01 * i) + cos(2 * M_PI * 0.3 * i);
+    }
+
+    size_t n_outputs = 0;
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        n_outputs += filter_process_block_decimator(
+            &input[block.start], &output[n_outputs], block.length, decimator
+        );
+    }
+    munit_assert_size(n_outputs, ==, TEST_SIGNAL_LENGTH / decimation);
+
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double expected = filter_evaluate_digital_filter_real(input[i], reference);
+        if (i % decimation == decimation - 1) {
+            munit_assert_double(output[i / decimation], ==, expected);
+        }
+    }
+
+    filter_free_decimator(decimator);
+    filter_free_digital_filter_real(reference);
+}
+
+void test_symmetry() {
+    DigitalFilterReal *sinc_filter = filter_make_sinc(0.1, 31, HIGH_PASS, window_hamming_symmetric);
+    DigitalFilterReal *periodic_sinc_filter = filter_make_sinc(0.1, 31, HIGH_PASS, window_hamming);
+    DigitalFilterReal *smoother = filter_make_savgol(11, 0, 2);
+    DigitalFilterReal *differentiator = filter_make_savgol(11, 1, 2);
+    munit_assert_int(sinc_filter->feedforward_symmetry, ==, SYMMETRIC);
+    munit_assert_int(periodic_sinc_filter->feedforward_symmetry, ==, ASYMMETRIC);
+    munit_assert_int(smoother->feedforward_symmetry, ==, SYMMETRIC);
+    munit_assert_int(differentiator->feedforward_symmetry, ==, ANTISYMMETRIC);
+
+    /**
+     * @brief 
+     * A quadratic polynomial fit reproduces a parabola exactly, 
+     * with the value and slope taken at the center of the window
+     */
+    for (int i = 0; i < 100; i++) {
+        double x = 0.1 * i;
+        double smoothed = filter_evaluate_digital_filter_real(x * x, smoother);
+        double slope = filter_evaluate_digital_filter_real(x * x, differentiator);
+        if (i >= 10) {
+            double center = 0.1 * (i - 5);
+            munit_assert_double_equal(smoothed, center * center, 9);
+            munit_assert_double_equal(slope, 0.1 * 2 * center, 9);
+        }
+    }
+
+    double input[TEST_SIGNAL_LENGTH];
+    double output[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * 0.02 * i) + cos(2 * M_PI * 0.3 * i);
+    }
+    filter_process_block_real(input, output, TEST_SIGNAL_LENGTH, sinc_filter);
+
+    const double *coefficients = vector_contiguous_elements_generic(sinc_filter->feedforward);
+    size_t n_taps = vector_length_generic(sinc_filter->feedforward);
+    for (size_t i = n_taps; i < TEST_SIGNAL_LENGTH; i++) {
+        double expected = 0;
+        for (size_t j = 0; j < n_taps; j++) {
+            expected += coefficients[j] * input[i + 1 - n_taps + j];
+        }
+        munit_assert_double_equal(output[i], expected, 12);
+    }
+
+    filter_free_digital_filter_real(sinc_filter);
+    filter_free_digital_filter_real(periodic_sinc_filter);
+    filter_free_digital_filter_real(smoother);
+    filter_free_digital_filter_real(differentiator);
+}
+
+void test_filter_bank(DigitalFilterReal *reference) {
+    const size_t n_channels = 8;
+    const size_t n_frames = 1000;
+    DigitalFilterBankReal *bank = filter_make_digital_filter_bank_real(reference->feedforward, n_channels);
+    munit_assert_not_null(bank);
+    munit_assert_int(bank->feedforward_symmetry, ==, reference->feedforward_symmetry);
+
+    static double input[8 * 1000];
+    static double output[8 * 1000];
+    for (size_t i = 0; i < n_frames; i++) {
+        for (size_t k = 0; k < n_channels; k++) {
+            input[i * n_channels + k] = sin(2 * M_PI * 0.01 * (k + 1) * i) + cos(2 * M_PI * 0.3 * i);
+        }
+    }
+    filter_process_block_digital_filter_bank_real(input, output, 600, bank);
+    for (size_t i = 600; i < n_frames; i++) {
+        filter_evaluate_digital_filter_bank_real(&input[i * n_channels], &output[i * n_channels], bank);
+    }
+
+    for (size_t k = 0; k < n_channels; k++) {
+        filter_reset_digital_filter_real(reference);
+        for (size_t i = 0; i < n_frames; i++) {
+            munit_assert_double(
+                output[i * n_channels + k], ==, 
+                filter_evaluate_digital_filter_real(input[i * n_channels + k], reference)
+            );
+        }
+    }
+
+    filter_free_digital_filter_bank_real(bank);
+}
+
+void test_mixed() {
+    DigitalFilterReal *real_part_filter = filter_make_sinc(0.1, 31, LOW_PASS, window_hamming_symmetric);
+    DigitalFilterReal *imag_part_filter = filter_make_sinc(0.1, 31, LOW_PASS, window_hamming_symmetric);
+    DigitalFilterMixed *sample_filter = filter_make_digital_filter_mixed_from_real(real_part_filter);
+    DigitalFilterMixed *block_filter = filter_make_digital_filter_mixed_from_real(real_part_filter);
+    munit_assert_not_null(sample_filter);
+    munit_assert_not_null(block_filter);
+
+    /**
+     * @brief 
+     * Mixed filters share a cached design, which outlives the real filters freed before them
+     */
+    munit_assert_not_null(sample_filter->design);
+    munit_assert_ptr_equal(sample_filter->design, real_part_filter->design);
+    munit_assert_ptr_equal(block_filter->feedforward, real_part_filter->feedforward);
+
+    const double alpha = 0.1;
+    VectorReal *ewma_feedforward = vector_real_new(1);
+    VectorReal *ewma_feedback = vector_real_new(1);
+    *vector_real_element(0, ewma_feedforward) = alpha;
+    *vector_real_element(0, ewma_feedback) = 1 - alpha;
+    DigitalFilterMixed *mixed_ewma = filter_make_digital_filter_mixed(ewma_feedforward, ewma_feedback);
+    DigitalFilterMixed *block_ewma = filter_make_digital_filter_mixed(ewma_feedforward, ewma_feedback);
+    DigitalFilterComplex *complex_ewma = filter_make_ewma(alpha);
+    munit_assert_not_null(mixed_ewma);
+    munit_assert_not_null(block_ewma);
+    munit_assert_null(mixed_ewma->design);
+
+    double complex input[TEST_SIGNAL_LENGTH];
+    double complex output[TEST_SIGNAL_LENGTH];
+    double complex ewma_output[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = cexp(I * 2 * M_PI * 0.01 * i) + 0.5 * cexp(I * 2 * M_PI * 0.4 * i);
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        filter_process_block_mixed(&input[block.start], &output[block.start], block.length, block_filter);
+        filter_process_block_mixed(&input[block.start], &ewma_output[block.start], block.length, block_ewma);
+    }
+
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double complex expected = filter_evaluate_digital_filter_mixed(input[i], sample_filter);
+        munit_assert_double(creal(output[i]), ==, creal(expected));
+        munit_assert_double(cimag(output[i]), ==, cimag(expected));
+        munit_assert_double(
+            creal(expected), ==, filter_evaluate_digital_filter_real(creal(input[i]), real_part_filter)
+        );
+        munit_assert_double(
+            cimag(expected), ==, filter_evaluate_digital_filter_real(cimag(input[i]), imag_part_filter)
+        );
+
+        double complex expected_ewma = filter_evaluate_digital_filter_mixed(input[i], mixed_ewma);
+        munit_assert_double(creal(ewma_output[i]), ==, creal(expected_ewma));
+        munit_assert_double(cimag(ewma_output[i]), ==, cimag(expected_ewma));
+        double complex complex_expected_ewma = filter_evaluate_digital_filter_complex(input[i], complex_ewma);
+        assert_complex_equal(expected_ewma, complex_expected_ewma, 12);
+    }
+
+    vector_real_free(ewma_feedforward);
+    vector_real_free(ewma_feedback);
+    filter_free_digital_filter_real(real_part_filter);
+    filter_free_digital_filter_real(imag_part_filter);
+    filter_free_digital_filter_mixed(sample_filter);
+    filter_free_digital_filter_mixed(block_filter);
+    filter_free_digital_filter_mixed(mixed_ewma);
+    filter_free_digital_filter_mixed(block_ewma);
+    filter_free_digital_filter_complex(complex_ewma);
+}
+
+void test_fixed_length() {
+    DigitalFilterReal *reference = filter_make_savgol(31, 1, 3);
+    munit_assert_not_null(reference);
+    FirReal31 sample_filter = FirReal31_make(reference->feedforward);
+    FirReal31 block_filter = FirReal31_make(reference->feedforward);
+
+    double input[TEST_SIGNAL_LENGTH];
+    double output[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * 0.02 * i) + cos(2 * M_PI * 0.3 * i);
+    }
+    FirReal31_process_block(input, output, TEST_SIGNAL_LENGTH, &block_filter);
+
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double expected = FirReal31_evaluate(input[i], &sample_filter);
+        munit_assert_double(output[i], ==, expected);
+        munit_assert_double_equal(
+            expected, filter_evaluate_digital_filter_real(input[i], reference), 12
+        );
+    }
+
+    FirReal31_reset(&sample_filter);
+    filter_reset_digital_filter_real(reference);
+    munit_assert_double_equal(
+        FirReal31_evaluate(1.0, &sample_filter), 
+        filter_evaluate_digital_filter_real(1.0, reference), 
+        12
+    );
+
+    filter_free_digital_filter_real(reference);
+}
+
+void test_design_cache() {
+    DigitalFilterReal *first = filter_make_savgol(21, 1, 2);
+    DigitalFilterReal *other_derivative = filter_make_savgol(21, 0, 2);
+    DigitalFilterReal *sinc_filter = filter_make_sinc(0.1, 21, LOW_PASS, window_hamming);
+    DigitalFilterReal *other_type = filter_make_sinc(0.1, 21, HIGH_PASS, window_hamming);
+    munit_assert_ptr_not_equal(first->feedforward, other_derivative->feedforward);
+    munit_assert_ptr_not_equal(sinc_filter->feedforward, other_type->feedforward);
+    munit_assert_not_null(first->design);
+
+#ifndef __STDC_NO_THREADS__
+    thrd_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        munit_assert_int(thrd_create(&threads[i], make_cached_filters, first), ==, thrd_success);
+    }
+    for (int i = 0; i < 4; i++) {
+        int result;
+        thrd_join(threads[i], &result);
+        munit_assert_int(result, ==, 1);
+    }
+#else
+    munit_assert_int(make_cached_filters(first), ==, 1);
+#endif
+
+    DigitalFilterReal *second_sinc = filter_make_sinc(0.1, 21, LOW_PASS, window_hamming);
+    munit_assert_ptr_equal(second_sinc->feedforward, sinc_filter->feedforward);
+
+    /**
+     * @brief 
+     * Shared coefficients stay valid until the last filter using them is freed
+     */
+    double expected = filter_evaluate_digital_filter_real(1.0, sinc_filter);
+    filter_free_digital_filter_real(sinc_filter);
+    munit_assert_double(filter_evaluate_digital_filter_real(1.0, second_sinc), ==, expected);
+    filter_free_digital_filter_real(second_sinc);
+
+    DigitalFilterReal *remade_sinc = filter_make_sinc(0.1, 21, LOW_PASS, window_hamming);
+    munit_assert_not_null(remade_sinc);
+    munit_assert_double(filter_evaluate_digital_filter_real(1.0, remade_sinc), ==, expected);
+
+    filter_free_digital_filter_real(first);
+    filter_free_digital_filter_real(other_derivative);
+    filter_free_digital_filter_real(other_type);
+    filter_free_digital_filter_real(remade_sinc);
+}
+
+int make_cached_filters(void *first_filter) {
+    const DigitalFilterReal *first = first_filter;
+    for (int i = 0; i < 100; i++) {
+        DigitalFilterReal *filter = filter_make_savgol(21, 1, 2);
+        DigitalFilterReal *new_design = filter_make_savgol(23 + 2 * (i % 5), 1, 2);
+        int is_shared = filter != NULL && new_design != NULL && filter->feedforward == first->feedforward;
+        filter_free_digital_filter_real(filter);
+        filter_free_digital_filter_real(new_design);
+        if (!is_shared)
+            return 0;
+    }
+    return 1;
+}
+
+void test_frequency_response(size_t n_points) {
+    DigitalFilterReal *sinc_filter = filter_make_sinc(0.1, 31, LOW_PASS, window_hamming_symmetric);
+    const double alpha = 0.2;
+    DigitalFilterComplex *ewma = filter_make_ewma(alpha);
+
+    FrequencyResponsePlan *plan = filter_make_frequency_response_plan(n_points);
+    munit_assert_not_null(plan);
+
+    const double *coefficients = vector_contiguous_elements_generic(sinc_filter->feedforward);
+    double complex response[1024];
+    double group_delay[1024];
+    filter_frequency_response_real(sinc_filter, plan, response, group_delay);
+    for (size_t k = 0; k < n_points; k++) {
+        double angular_frequency = 2 * M_PI * k / n_points;
+        double complex expected = 0;
+        for (size_t i = 0; i < 31; i++) {
+            expected += 
+                coefficients[i] * 
+                cexp(-I * angular_frequency * (30 - i));
+        }
+        assert_complex_equal(response[k], expected, 10);
+        if (cabs(expected) > 1e-3) {
+            munit_assert_double_equal(group_delay[k], 15.0, 6);
+        }
+    }
+
+    /**
+     * @brief 
+     * The plan is reused between filters, with and without feedback terms
+     */
+    double complex fir_response[1024];
+    for (size_t k = 0; k < n_points; k++) {
+        fir_response[k] = response[k];
+    }
+    filter_frequency_response_complex(ewma, plan, response, NULL);
+    filter_frequency_response_complex(ewma, plan, response, group_delay);
+    for (size_t k = 0; k < n_points; k++) {
+        double complex delay = cexp(-I * 2 * M_PI * k / n_points);
+        double complex expected = alpha / (1 - (1 - alpha) * delay);
+        assert_complex_equal(response[k], expected, 10);
+        double expected_delay = creal((1 - alpha) * delay / (1 - (1 - alpha) * delay));
+        munit_assert_double_equal(group_delay[k], expected_delay, 10);
+    }
+
+    filter_frequency_response_real(sinc_filter, plan, response, NULL);
+    for (size_t k = 0; k < n_points; k++) {
+        munit_assert_double(creal(response[k]), ==, creal(fir_response[k]));
+        munit_assert_double(cimag(response[k]), ==, cimag(fir_response[k]));
+    }
+
+    filter_free_frequency_response_plan(plan);
+    filter_free_digital_filter_real(sinc_filter);
+    filter_free_digital_filter_complex(ewma);
+}
+
 int test_filter(
     char *output_filename, 
     double input[], 
@@ -80,5 +480,3 @@ int test_filter(
     fclose(output_file);
     return 1;
 }
-
-
@@ -0,0 +1,242 @@
+#include <math.h>
+#include <complex.h>
+#include "moving_average.h"
+#include "test.h"
+#include "constants.h"
+
+#define TEST_SIGNAL_LENGTH 20000
+
+void test_block(size_t length);
+void test_cascade(size_t length, size_t n_stages);
+void test_stats(size_t length);
+void test_stats_bank(size_t length, size_t n_channels);
+
+/**
+ * @brief 
+ * Deterministic test signal on a large offset, where a running sum of squares loses most of its precision
+ */
+double test_signal(size_t i, size_t channel);
+
+int main() {
+    test_block(1);
+    test_block(64);
+    test_block(1000);
+    test_cascade(1, 3);
+    test_cascade(17, 4);
+    test_cascade(1000, 2);
+    test_stats(1);
+    test_stats(100);
+    test_stats(4097);
+    test_stats_bank(100, 7);
+    return 0;
+}
+
+void test_block(size_t length) {
+    MovingAverageReal *sample_filter = moving_average_real_make(length);
+    MovingAverageReal *block_filter = moving_average_real_make(length);
+    MovingAverageComplex *complex_sample_filter = moving_average_complex_make(length);
+    MovingAverageComplex *complex_block_filter = moving_average_complex_make(length);
+    munit_assert_not_null(sample_filter);
+    munit_assert_not_null(block_filter);
+    munit_assert_not_null(complex_sample_filter);
+    munit_assert_not_null(complex_block_filter);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    static double complex complex_input[TEST_SIGNAL_LENGTH];
+    static double complex complex_output[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(0.003 * i) + 0.01 * (double) ((i * 7919) % 17);
+        complex_input[i] = CMPLX(input[i], cos(0.005 * i));
+        output[i] = input[i];
+    }
+
+    /**
+     * @brief 
+     * The real filter runs in place
+     */
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        moving_average_real_process_block(
+            &output[block.start], &output[block.start], block.length, block_filter
+        );
+        moving_average_complex_process_block(
+            &complex_input[block.start], &complex_output[block.start], block.length, complex_block_filter
+        );
+    }
+
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double value = moving_average_real_evaluate(input[i], sample_filter);
+        double complex complex_value = moving_average_complex_evaluate(complex_input[i], complex_sample_filter);
+        munit_assert_double(value, ==, output[i]);
+        munit_assert_double(creal(complex_value), ==, creal(complex_output[i]));
+        munit_assert_double(cimag(complex_value), ==, cimag(complex_output[i]));
+
+        if (i % 17 == 0) {
+            double sum = 0;
+            for (size_t j = 0; j < length && j <= i; j++) {
+                sum += input[i - j];
+            }
+            munit_assert_double_equal(value, sum / length, 9);
+        }
+    }
+
+    moving_average_real_free(sample_filter);
+    moving_average_real_free(block_filter);
+    moving_average_complex_free(complex_sample_filter);
+    moving_average_complex_free(complex_block_filter);
+}
+
+void test_cascade(size_t length, size_t n_stages) {
+    MovingAverageCascadeReal *sample_filter = moving_average_cascade_real_make(length, n_stages);
+    MovingAverageCascadeReal *block_filter = moving_average_cascade_real_make(length, n_stages);
+    munit_assert_not_null(sample_filter);
+    munit_assert_not_null(block_filter);
+    MovingAverageReal *stages[8];
+    munit_assert_size(n_stages, <=, 8);
+    for (size_t k = 0; k < n_stages; k++) {
+        stages[k] = moving_average_real_make(length);
+        munit_assert_not_null(stages[k]);
+    }
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(0.003 * i) + 0.01 * (double) ((i * 7919) % 17);
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        moving_average_cascade_real_process_block(
+            &input[block.start], &output[block.start], block.length, block_filter
+        );
+    }
+
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double value = moving_average_cascade_real_evaluate(input[i], sample_filter);
+        munit_assert_double(value, ==, output[i]);
+
+        double expected = input[i];
+        for (size_t k = 0; k < n_stages; k++) {
+            expected = moving_average_real_evaluate(expected, stages[k]);
+        }
+        munit_assert_double_equal(value, expected, 9);
+    }
+
+    /**
+     * @brief 
+     * Each stage's running sum is recomputed when the ring wraps, 
+     * so after a large-offset signal and enough zeros to reach every stage the output is exactly zero
+     */
+    size_t n_zeros = 2 * n_stages * length;
+    munit_assert_size(n_zeros, <=, TEST_SIGNAL_LENGTH);
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = i < TEST_SIGNAL_LENGTH - n_zeros ? test_signal(i, 0) : 0;
+    }
+    moving_average_cascade_real_process_block(input, output, TEST_SIGNAL_LENGTH, block_filter);
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        munit_assert_double(moving_average_cascade_real_evaluate(input[i], sample_filter), ==, output[i]);
+    }
+    munit_assert_double(output[TEST_SIGNAL_LENGTH - 1], ==, 0.0);
+
+    moving_average_cascade_real_reset(sample_filter);
+    munit_assert_double(
+        moving_average_cascade_real_evaluate(input[0], sample_filter), ==, input[0] * sample_filter->scale
+    );
+
+    moving_average_cascade_real_free(sample_filter);
+    moving_average_cascade_real_free(block_filter);
+    for (size_t k = 0; k < n_stages; k++) {
+        moving_average_real_free(stages[k]);
+    }
+}
+
+void test_stats(size_t length) {
+    MovingStatsReal *sample_filter = moving_stats_real_make(length);
+    MovingStatsReal *block_filter = moving_stats_real_make(length);
+    munit_assert_not_null(sample_filter);
+    munit_assert_not_null(block_filter);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static Statistics output[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = test_signal(i, 0);
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        moving_stats_real_process_block(
+            &input[block.start], &output[block.start], block.length, block_filter
+        );
+    }
+
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        Statistics statistics = moving_stats_real_evaluate(input[i], sample_filter);
+        munit_assert_double(statistics.mean, ==, output[i].mean);
+        munit_assert_double(statistics.variance, ==, output[i].variance);
+        munit_assert_double(statistics.rms, ==, output[i].rms);
+
+        if (i >= length && i % 13 == 0) {
+            double sum = 0;
+            for (size_t j = i + 1 - length; j <= i; j++) {
+                sum += input[j];
+            }
+            double mean = sum / length;
+            double squared_deviation_sum = 0;
+            double square_sum = 0;
+            for (size_t j = i + 1 - length; j <= i; j++) {
+                squared_deviation_sum += (input[j] - mean) * (input[j] - mean);
+                square_sum += input[j] * input[j];
+            }
+            double variance = squared_deviation_sum / length;
+
+            munit_assert_double_equal(statistics.mean, mean, 6);
+            munit_assert_double(fabs(statistics.variance - variance), <=, 1e-6 * (variance + 1e-3));
+            munit_assert_double_equal(statistics.standard_deviation, sqrt(variance), 4);
+            munit_assert_double_equal(statistics.rms, sqrt(square_sum / length), 6);
+        }
+    }
+
+    moving_stats_real_reset(sample_filter);
+    munit_assert_double(moving_stats_real_evaluate(input[0], sample_filter).mean, ==, output[0].mean);
+
+    moving_stats_real_free(sample_filter);
+    moving_stats_real_free(block_filter);
+}
+
+void test_stats_bank(size_t length, size_t n_channels) {
+    MovingStatsBankReal *bank = moving_stats_bank_real_make(length, n_channels);
+    munit_assert_not_null(bank);
+    MovingStatsReal *channels[16];
+    munit_assert_size(n_channels, <=, 16);
+    for (size_t c = 0; c < n_channels; c++) {
+        channels[c] = moving_stats_real_make(length);
+        munit_assert_not_null(channels[c]);
+    }
+
+    double input[16];
+    double mean[16];
+    double variance[16];
+    double rms[16];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH / 4; i++) {
+        for (size_t c = 0; c < n_channels; c++) {
+            input[c] = test_signal(i, c);
+        }
+        moving_stats_bank_real_evaluate(input, mean, variance, i % 2 == 0 ? rms : NULL, bank);
+
+        for (size_t c = 0; c < n_channels; c++) {
+            Statistics statistics = moving_stats_real_evaluate(input[c], channels[c]);
+            munit_assert_double(mean[c], ==, statistics.mean);
+            munit_assert_double(variance[c], ==, statistics.variance);
+            if (i % 2 == 0) {
+                munit_assert_double(rms[c], ==, statistics.rms);
+            }
+        }
+    }
+
+    moving_stats_bank_real_free(bank);
+    for (size_t c = 0; c < n_channels; c++) {
+        moving_stats_real_free(channels[c]);
+    }
+}
+
+double test_signal(size_t i, size_t channel) {
+    return 1e6 * (channel + 1) + sin(0.003 * i * (channel + 1)) + 0.01 * (double) ((i * 7919) % 17);
+}
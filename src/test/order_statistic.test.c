@@ -0,0 +1,185 @@
+#include <math.h>
+#include <stdlib.h>
+#include "order_statistic.h"
+#include "test.h"
+
+#define TEST_SIGNAL_LENGTH 30000
+
+void test_order_statistic(size_t length, size_t rank, size_t check_interval);
+void test_median(size_t length);
+void test_min_max(size_t length);
+
+/**
+ * @brief 
+ * Calculates an order statistic of a window by sorting a copy of it
+ * @return Value of rank `rank`
+ */
+double reference_order_statistic(const double *window, size_t length, size_t rank);
+
+/**
+ * @brief 
+ * Deterministic test signal with spikes and many repeated values
+ */
+double test_signal(size_t i);
+
+int main() {
+    test_order_statistic(101, 50, 1);
+    test_order_statistic(31, 0, 1);
+    test_order_statistic(31, 30, 1);
+    test_order_statistic(40, 7, 1);
+    test_order_statistic(1, 0, 1);
+    test_order_statistic(10001, 9000, 997);
+    test_median(64);
+    test_median(10001);
+    test_min_max(1);
+    test_min_max(5);
+    test_min_max(300);
+    test_min_max(2000);
+    return 0;
+}
+
+void test_order_statistic(size_t length, size_t rank, size_t check_interval) {
+    MovingOrderStatisticReal *sample_filter = moving_order_statistic_real_make(length, rank);
+    MovingOrderStatisticReal *block_filter = moving_order_statistic_real_make(length, rank);
+    munit_assert_not_null(sample_filter);
+    munit_assert_not_null(block_filter);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = test_signal(i);
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        moving_order_statistic_real_process_block(
+            &input[block.start], &output[block.start], block.length, block_filter
+        );
+    }
+
+    double *window = calloc(length, sizeof(double));
+    munit_assert_not_null(window);
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        window[i % length] = input[i];
+        double value = moving_order_statistic_real_evaluate(input[i], sample_filter);
+        munit_assert_double(value, ==, output[i]);
+        if (i % check_interval == 0) {
+            munit_assert_double(value, ==, reference_order_statistic(window, length, rank));
+        }
+    }
+
+    moving_order_statistic_real_reset(sample_filter);
+    munit_assert_double(moving_order_statistic_real_evaluate(input[0], sample_filter), ==, output[0]);
+
+    free(window);
+    moving_order_statistic_real_free(sample_filter);
+    moving_order_statistic_real_free(block_filter);
+}
+
+void test_median(size_t length) {
+    MovingMedianReal *filter = moving_median_real_make(length);
+    munit_assert_not_null(filter);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = test_signal(i);
+    }
+    moving_median_real_process_block(input, output, TEST_SIGNAL_LENGTH, filter);
+
+    double *window = calloc(length, sizeof(double));
+    munit_assert_not_null(window);
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        window[i % length] = input[i];
+        if (i % 101 == 0) {
+            double expected = length % 2 == 1 ?
+                reference_order_statistic(window, length, length / 2) :
+                (reference_order_statistic(window, length, length / 2 - 1) +
+                    reference_order_statistic(window, length, length / 2)) / 2;
+            munit_assert_double(output[i], ==, expected);
+        }
+    }
+
+    free(window);
+    moving_median_real_free(filter);
+}
+
+void test_min_max(size_t length) {
+    MovingMinMaxReal *sample_filter = moving_min_max_real_make(length);
+    MovingMinMaxReal *block_filter = moving_min_max_real_make(length);
+    munit_assert_not_null(sample_filter);
+    munit_assert_not_null(block_filter);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static MinMax output[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = test_signal(i);
+    }
+
+    /**
+     * @brief 
+     * Blocks shorter and longer than the window exercise both block algorithms
+     */
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        moving_min_max_real_process_block(
+            &input[block.start], &output[block.start], block.length, block_filter
+        );
+    }
+
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        MinMax value = moving_min_max_real_evaluate(input[i], sample_filter);
+        munit_assert_double(value.min, ==, output[i].min);
+        munit_assert_double(value.max, ==, output[i].max);
+        munit_assert_size(value.min_age, ==, output[i].min_age);
+        munit_assert_size(value.max_age, ==, output[i].max_age);
+
+        if (i % 7 == 0) {
+            MinMax expected = {.min = input[i], .max = input[i], .min_age = 0, .max_age = 0};
+            for (size_t age = 1; age < length; age++) {
+                double previous = age <= i ? input[i - age] : 0.0;
+                if (previous < expected.min) {
+                    expected.min = previous;
+                    expected.min_age = age;
+                }
+                if (previous > expected.max) {
+                    expected.max = previous;
+                    expected.max_age = age;
+                }
+            }
+            munit_assert_double(value.min, ==, expected.min);
+            munit_assert_double(value.max, ==, expected.max);
+            munit_assert_size(value.min_age, ==, expected.min_age);
+            munit_assert_size(value.max_age, ==, expected.max_age);
+        }
+    }
+
+    moving_min_max_real_reset(sample_filter);
+    MinMax first = moving_min_max_real_evaluate(input[0], sample_filter);
+    munit_assert_double(first.max, ==, output[0].max);
+    munit_assert_size(first.min_age, ==, output[0].min_age);
+
+    moving_min_max_real_free(sample_filter);
+    moving_min_max_real_free(block_filter);
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+double reference_order_statistic(const double *window, size_t length, size_t rank) {
+    double *sorted = malloc(length * sizeof(double));
+    munit_assert_not_null(sorted);
+    for (size_t i = 0; i < length; i++) {
+        sorted[i] = window[i];
+    }
+    qsort(sorted, length, sizeof(double), compare_doubles);
+    double value = sorted[rank];
+    free(sorted);
+    return value;
+}
+
+double test_signal(size_t i) {
+    double value = round(20 * sin(0.001 * i)) + (double) ((i * 7919) % 13) - 6;
+    return i % 53 == 0 ? 1000.0 : value;
+}
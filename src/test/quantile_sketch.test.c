@@ -0,0 +1,97 @@
+#include <math.h>
+#include <stdlib.h>
+#include "quantile_sketch.h"
+#include "test.h"
+
+#define TEST_SIGNAL_LENGTH 250000
+
+void test_quantiles(size_t block_length, size_t n_blocks, double relative_accuracy);
+
+/**
+ * @brief 
+ * Deterministic heavy-tailed test signal with some negative values and exact zeros
+ */
+double test_signal(size_t i);
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+int main() {
+    test_quantiles(1000, 100, 0.01);
+    test_quantiles(4096, 7, 0.002);
+    return 0;
+}
+
+void test_quantiles(size_t block_length, size_t n_blocks, double relative_accuracy) {
+    QuantileSketchReal *sample_sketch =
+        quantile_sketch_real_make(block_length, n_blocks, relative_accuracy, 1e-6, 1e6);
+    QuantileSketchReal *block_sketch =
+        quantile_sketch_real_make(block_length, n_blocks, relative_accuracy, 1e-6, 1e6);
+    munit_assert_not_null(sample_sketch);
+    munit_assert_not_null(block_sketch);
+
+    const double probabilities[] = {0.0, 0.01, 0.5, 0.95, 0.99, 1.0};
+    for (size_t j = 0; j < 6; j++) {
+        munit_assert_double(quantile_sketch_real_quantile(probabilities[j], sample_sketch), ==, 0.0);
+    }
+
+    static double input[TEST_SIGNAL_LENGTH];
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = test_signal(i);
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        quantile_sketch_real_insert_block(&input[block.start], block.length, block_sketch);
+    }
+
+    size_t window_length = block_length * n_blocks;
+    double *window = malloc(window_length * sizeof(double));
+    munit_assert_not_null(window);
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        quantile_sketch_real_insert(input[i], sample_sketch);
+
+        /**
+         * @brief 
+         * Each complete sub-window is checked against the exact quantiles of the inputs it covers,
+         * including the initial zeros
+         */
+        if ((i + 1) % block_length == 0 && (i + 1) / block_length % 5 == 0) {
+            for (size_t k = 0; k < window_length; k++) {
+                window[k] = i + 1 + k >= window_length ? input[i + 1 + k - window_length] : 0.0;
+            }
+            qsort(window, window_length, sizeof(double), compare_doubles);
+
+            for (size_t j = 0; j < 6; j++) {
+                double expected = window[(size_t) round(probabilities[j] * (window_length - 1))];
+                double quantile = quantile_sketch_real_quantile(probabilities[j], sample_sketch);
+                munit_assert_double(fabs(quantile - expected), <=, relative_accuracy * fabs(expected) + 1e-12);
+            }
+        }
+    }
+
+    for (size_t j = 0; j < 6; j++) {
+        munit_assert_double(
+            quantile_sketch_real_quantile(probabilities[j], block_sketch), ==, 
+            quantile_sketch_real_quantile(probabilities[j], sample_sketch)
+        );
+    }
+
+    quantile_sketch_real_reset(sample_sketch);
+    munit_assert_double(quantile_sketch_real_evaluate(1.0, 0.99, sample_sketch), ==, 0.0);
+
+    free(window);
+    quantile_sketch_real_free(sample_sketch);
+    quantile_sketch_real_free(block_sketch);
+}
+
+double test_signal(size_t i) {
+    double uniform = (double) ((i * 2654435761u) % 1000003) / 1000003.0;
+    if (i % 97 == 0)
+        return 0.0;
+    if (i % 11 == 0)
+        return -10 * uniform;
+    return -log(1 - uniform) * (1 + 0.5 * sin(1e-4 * i));
+}
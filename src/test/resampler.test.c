@@ -0,0 +1,142 @@
+#include <math.h>
+#include <complex.h>
+#include "resampler.h"
+#include "window.h"
+#include "test.h"
+#include "constants.h"
+
+#define TEST_SIGNAL_LENGTH 6000
+
+void test_rational(size_t interpolation, size_t decimation);
+void test_farrow(enum FarrowOrder order, double ratio);
+
+int main() {
+    test_rational(3, 2);
+    test_rational(147, 160);
+    test_rational(1, 4);
+    test_farrow(FARROW_CUBIC, 1.0001);
+    test_farrow(FARROW_CUBIC, 0.75);
+    test_farrow(FARROW_QUINTIC, 1.3);
+    return 0;
+}
+
+void test_rational(size_t interpolation, size_t decimation) {
+    const size_t taps_per_phase = 32;
+    const double frequency = 0.01;
+    RationalResamplerReal *whole = resampler_rational_real_make_sinc(
+        interpolation, decimation, taps_per_phase, window_hamming
+    );
+    RationalResamplerReal *split = resampler_rational_real_make_sinc(
+        interpolation, decimation, taps_per_phase, window_hamming
+    );
+    munit_assert_not_null(whole);
+    munit_assert_not_null(split);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double whole_output[TEST_SIGNAL_LENGTH * 4];
+    static double split_output[TEST_SIGNAL_LENGTH * 4];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * frequency * i);
+    }
+
+    size_t n_outputs = resampler_rational_real_process_block(
+        input, whole_output, TEST_SIGNAL_LENGTH, whole
+    );
+    munit_assert_size(
+        n_outputs, ==, 
+        (TEST_SIGNAL_LENGTH * interpolation + decimation - 1) / decimation
+    );
+
+    size_t n_split_outputs = 0;
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        n_split_outputs += resampler_rational_real_process_block(
+            &input[block.start], &split_output[n_split_outputs], block.length, split
+        );
+    }
+    munit_assert_size(n_split_outputs, ==, n_outputs);
+
+    /**
+     * @brief 
+     * Output n is taken at upsampled time n M, 
+     * delayed by half of the prototype filter length
+     */
+    double delay = (interpolation * taps_per_phase - 1) / 2 / (double) interpolation;
+    for (size_t n = 0; n < n_outputs; n++) {
+        munit_assert_double(whole_output[n], ==, split_output[n]);
+        double input_time = (double) n * decimation / interpolation - delay;
+        if (input_time > taps_per_phase) {
+            munit_assert_double_equal(
+                whole_output[n], sin(2 * M_PI * frequency * input_time), 2
+            );
+        }
+    }
+
+    resampler_rational_real_free(whole);
+    resampler_rational_real_free(split);
+}
+
+void test_farrow(enum FarrowOrder order, double ratio) {
+    const double frequency = 0.01;
+
+    VectorReal *samples = vector_real_new(64);
+    for (int i = 0; i < 64; i++) {
+        *vector_real_element(i, samples) = sin(2 * M_PI * frequency * i);
+    }
+    for (double index = 3.0; index < 60.0; index += 0.37) {
+        munit_assert_double_equal(
+            resampler_farrow_real_interpolate(index, order, samples),
+            sin(2 * M_PI * frequency * index),
+            5
+        );
+    }
+    vector_real_free(samples);
+
+    FarrowResamplerReal *whole = resampler_farrow_real_make(order);
+    FarrowResamplerReal *split = resampler_farrow_real_make(order);
+    FarrowResamplerComplex *complex_resampler = resampler_farrow_complex_make(order);
+    munit_assert_not_null(whole);
+    munit_assert_not_null(split);
+    munit_assert_not_null(complex_resampler);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double complex complex_input[TEST_SIGNAL_LENGTH];
+    static double whole_output[TEST_SIGNAL_LENGTH * 2];
+    static double split_output[TEST_SIGNAL_LENGTH * 2];
+    static double complex complex_output[TEST_SIGNAL_LENGTH * 2];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * frequency * i);
+        complex_input[i] = CMPLX(input[i], cos(2 * M_PI * frequency * i));
+    }
+
+    size_t n_outputs = resampler_farrow_real_process_block(
+        input, whole_output, TEST_SIGNAL_LENGTH, ratio, whole
+    );
+    munit_assert_size(n_outputs, <=, (size_t) ceil(TEST_SIGNAL_LENGTH * ratio) + 1);
+    munit_assert_size(
+        resampler_farrow_complex_process_block(
+            complex_input, complex_output, TEST_SIGNAL_LENGTH, ratio, complex_resampler
+        ), ==, n_outputs
+    );
+
+    size_t n_split_outputs = 0;
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        n_split_outputs += resampler_farrow_real_process_block(
+            &input[block.start], &split_output[n_split_outputs], block.length, ratio, split
+        );
+    }
+    munit_assert_size(n_split_outputs, ==, n_outputs);
+
+    for (size_t n = 0; n < n_outputs; n++) {
+        munit_assert_double(whole_output[n], ==, split_output[n]);
+        munit_assert_double(whole_output[n], ==, creal(complex_output[n]));
+        double input_time = n / ratio;
+        if (input_time > order) {
+            munit_assert_double_equal(whole_output[n], sin(2 * M_PI * frequency * input_time), 5);
+            munit_assert_double_equal(cimag(complex_output[n]), cos(2 * M_PI * frequency * input_time), 5);
+        }
+    }
+
+    resampler_farrow_real_free(whole);
+    resampler_farrow_real_free(split);
+    resampler_farrow_complex_free(complex_resampler);
+}
@@ -0,0 +1,189 @@
+#include <stdlib.h>
+#include <math.h>
+#include "savgol.h"
+#include "filter.h"
+#include "test.h"
+#include "constants.h"
+
+void test_weights(int window, int polyorder, int center);
+void test_large_window();
+void test_filter_modes();
+void test_filter_order(int window, int polyorder, int derivative);
+
+int main() {
+    test_weights(11, 4, 0);
+    test_weights(21, 3, 4);
+    test_weights(7, 6, 0);
+    test_large_window();
+    test_filter_order(11, 2, 1);
+    test_filter_order(9, 3, 0);
+    test_filter_modes();
+    return 0;
+}
+
+void test_weights(int window, int polyorder, int center) {
+    double *weights = malloc(sizeof(double) * window * (polyorder + 1));
+    munit_assert_not_null(weights);
+    munit_assert_true(savgol_weights(center, window, polyorder, polyorder, weights));
+
+    for (int s = 0; s <= polyorder; s++) {
+        for (int i = 0; i < window; i++) {
+            munit_assert_double_equal(
+                weights[s * window + i], 
+                savgol_weight(i, center, window, polyorder, s), 
+                10
+            );
+        }
+    }
+    free(weights);
+}
+
+void test_large_window() {
+    const int window = 4001;
+    const int polyorder = 4;
+    double *weights = malloc(sizeof(double) * window * 2);
+    munit_assert_not_null(weights);
+    munit_assert_true(savgol_weights(0, window, polyorder, 1, weights));
+
+    /**
+     * @brief 
+     * The smoothing weights sum to one and the slope weights reproduce a unit ramp
+     */
+    double sum = 0;
+    double slope = 0;
+    for (int i = 0; i < window; i++) {
+        sum += weights[i];
+        slope += weights[window + i] * i;
+    }
+    munit_assert_double_equal(sum, 1.0, 9);
+    munit_assert_double_equal(slope, 1.0, 9);
+    free(weights);
+}
+
+void test_filter_modes() {
+    const size_t length = 1000;
+    const int window = 31;
+    const int half_window = window / 2;
+    static double input[1000];
+    static double output[1000];
+    static double slope[1000];
+
+    /**
+     * @brief 
+     * A cubic fit reproduces a parabola and its derivative exactly, including at the edges
+     */
+    for (size_t i = 0; i < length; i++) {
+        double x = 0.01 * i;
+        input[i] = 3 - x + 2 * x * x;
+    }
+    munit_assert_true(savgol_filter(input, output, length, window, 3, 0, SAVGOL_MODE_INTERP));
+    munit_assert_true(savgol_filter(input, slope, length, window, 3, 1, SAVGOL_MODE_INTERP));
+    for (size_t i = 0; i < length; i++) {
+        double x = 0.01 * i;
+        munit_assert_double_equal(output[i], input[i], 9);
+        munit_assert_double_equal(slope[i], 0.01 * (-1 + 4 * x), 9);
+    }
+
+    /**
+     * @brief 
+     * The interior matches the causal filter, delayed by half a window
+     */
+    DigitalFilterReal *causal = filter_make_savgol(window, 0, 3);
+    for (size_t i = 0; i < length; i++) {
+        input[i] = sin(2 * M_PI * 0.01 * i) + 0.3 * cos(2 * M_PI * 0.37 * i);
+    }
+    munit_assert_true(savgol_filter(input, output, length, window, 3, 0, SAVGOL_MODE_MIRROR));
+    for (size_t i = 0; i < length; i++) {
+        double expected = filter_evaluate_digital_filter_real(input[i], causal);
+        if (i >= (size_t) window - 1) {
+            munit_assert_double_equal(output[i - half_window], expected, 10);
+        }
+    }
+    filter_free_digital_filter_real(causal);
+
+    /**
+     * @brief 
+     * The edges match convolving the explicitly extended signal
+     */
+    static double extended[1000 + 30];
+    double weights[31];
+    munit_assert_true(savgol_weights(0, window, 2, 0, weights));
+    const enum SavgolMode modes[] = {SAVGOL_MODE_MIRROR, SAVGOL_MODE_NEAREST};
+    for (int m = 0; m < 2; m++) {
+        for (int j = 0; j < (int) length + 2 * half_window; j++) {
+            int index = j - half_window;
+            if (index < 0)
+                index = modes[m] == SAVGOL_MODE_MIRROR ? -index : 0;
+            if (index >= (int) length)
+                index = modes[m] == SAVGOL_MODE_MIRROR ? 2 * ((int) length - 1) - index : (int) length - 1;
+            extended[j] = input[index];
+        }
+        munit_assert_true(savgol_filter(input, output, length, window, 2, 0, modes[m]));
+        for (size_t i = 0; i < length; i++) {
+            double expected = 0;
+            for (int k = 0; k < window; k++) {
+                expected += weights[k] * extended[i + k];
+            }
+            munit_assert_double_equal(output[i], expected, 12);
+        }
+    }
+
+    /**
+     * @brief 
+     * The interpolated edges match the weights of a fit centered away from the middle of the end windows
+     */
+    double edge_weights[2 * 31];
+    munit_assert_true(savgol_filter(input, slope, length, window, 3, 1, SAVGOL_MODE_INTERP));
+    for (int p = 0; p < half_window; p++) {
+        int offset = half_window - p;
+        munit_assert_true(savgol_weights(-offset, window, 3, 1, edge_weights));
+        double start = 0;
+        for (int k = 0; k < window; k++) {
+            start += edge_weights[window + k] * input[k];
+        }
+        munit_assert_true(savgol_weights(offset, window, 3, 1, edge_weights));
+        double end = 0;
+        for (int k = 0; k < window; k++) {
+            end += edge_weights[window + k] * input[length - window + k];
+        }
+        munit_assert_double_equal(slope[p], start, 10);
+        munit_assert_double_equal(slope[length - 1 - p], end, 10);
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        input[i] = 2.5;
+    }
+    munit_assert_true(savgol_filter(input, output, length, window, 2, 0, SAVGOL_MODE_NEAREST));
+    munit_assert_true(savgol_filter(input, slope, length, window, 2, 1, SAVGOL_MODE_NEAREST));
+    for (size_t i = 0; i < length; i++) {
+        munit_assert_double_equal(output[i], 2.5, 10);
+        munit_assert_double_equal(slope[i], 0.0, 10);
+    }
+}
+
+void test_filter_order(int window, int polyorder, int derivative) {
+    DigitalFilterReal *filter = filter_make_savgol(window, derivative, polyorder);
+    munit_assert_not_null(filter);
+
+    /**
+     * @brief 
+     * Filter coefficients are the weights in canonical order, oldest input first
+     */
+    const double *coefficients = vector_contiguous_elements_generic(filter->feedforward);
+    for (int i = 0; i < window; i++) {
+        munit_assert_double_equal(coefficients[i], savgol_weight(i, 0, window, polyorder, derivative), 10);
+    }
+
+    /**
+     * @brief 
+     * A rising ramp is estimated at the center of the window, with a positive slope
+     */
+    double value = 0;
+    for (int i = 0; i < 2 * window; i++) {
+        value = filter_evaluate_digital_filter_real(i, filter);
+    }
+    int center = 2 * window - 1 - window / 2;
+    munit_assert_double_equal(value, derivative == 0 ? center : 1.0, 9);
+
+    filter_free_digital_filter_real(filter);
+}
@@ -0,0 +1,107 @@
+#include <math.h>
+#include "sparse_filter.h"
+#include "filter.h"
+#include "test.h"
+#include "window.h"
+#include "constants.h"
+
+#define TEST_SIGNAL_LENGTH 6000
+
+void test_sparse();
+void test_half_band();
+
+int main() {
+    test_sparse();
+    test_half_band();
+    return 0;
+}
+
+void test_sparse() {
+    const size_t length = 64;
+    VectorReal *comb = vector_real_new(length);
+    for (size_t i = 0; i < length; i++) {
+        *vector_real_element(i, comb) = i % 16 == 0 || i == length - 1 ? 1.0 / (i + 1) : 0.0;
+    }
+
+    DigitalFilterReal *dense = filter_make_digital_filter_real(comb, NULL);
+    SparseFilterReal *sample_filter = sparse_filter_real_make(comb);
+    SparseFilterReal *block_filter = sparse_filter_real_make(comb);
+    munit_assert_not_null(dense);
+    munit_assert_not_null(sample_filter);
+    munit_assert_not_null(block_filter);
+    munit_assert_size(sample_filter->n_nonzero, ==, 5);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * 0.02 * i) + cos(2 * M_PI * 0.3 * i);
+    }
+
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        sparse_filter_real_process_block(&input[block.start], &output[block.start], block.length, block_filter);
+    }
+
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double expected = sparse_filter_real_evaluate(input[i], sample_filter);
+        munit_assert_double(output[i], ==, expected);
+        munit_assert_double_equal(expected, filter_evaluate_digital_filter_real(input[i], dense), 12);
+    }
+
+    vector_real_free(comb);
+    filter_free_digital_filter_real(dense);
+    sparse_filter_real_free(sample_filter);
+    sparse_filter_real_free(block_filter);
+}
+
+void test_half_band() {
+    const size_t length = 63;
+    HalfBandDecimatorReal *decimator = half_band_decimator_real_make(length, window_hamming_symmetric);
+    munit_assert_not_null(decimator);
+    munit_assert_size(decimator->n_folded, ==, 16);
+
+    VectorReal *feedforward = vector_real_new(length);
+    for (size_t i = 0; i < length; i++) {
+        *vector_real_element(i, feedforward) = 0.0;
+    }
+    *vector_real_element(length / 2, feedforward) = 0.5;
+    for (size_t j = 0; j < decimator->n_folded; j++) {
+        *vector_real_element(2 * j, feedforward) = decimator->coefficients[j];
+        *vector_real_element(length - 1 - 2 * j, feedforward) = decimator->coefficients[j];
+    }
+    DigitalFilterReal *reference = filter_make_digital_filter_real(feedforward, NULL);
+    munit_assert_not_null(reference);
+
+    static double input[TEST_SIGNAL_LENGTH];
+    static double output[TEST_SIGNAL_LENGTH / 2];
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        input[i] = sin(2 * M_PI * 0.02 * i) + cos(2 * M_PI * 0.4 * i);
+    }
+
+    size_t n_outputs = 0;
+    for_each_test_block(block, TEST_SIGNAL_LENGTH) {
+        n_outputs += half_band_decimator_real_process_block(
+            &input[block.start], &output[n_outputs], block.length, decimator
+        );
+    }
+    munit_assert_size(n_outputs, ==, TEST_SIGNAL_LENGTH / 2);
+
+    /**
+     * @brief 
+     * The 0.4 component is above the quarter-rate cutoff and is removed. 
+     * The 0.02 component is passed, delayed by half of the filter length.
+     */
+    for (int i = 0; i < TEST_SIGNAL_LENGTH; i++) {
+        double expected = filter_evaluate_digital_filter_real(input[i], reference);
+        if (i % 2 == 1) {
+            munit_assert_double_equal(output[i / 2], expected, 12);
+            if (i >= (int) length) {
+                double delayed_time = i - (double) (length / 2);
+                munit_assert_double_equal(output[i / 2], sin(2 * M_PI * 0.02 * delayed_time), 2);
+            }
+        }
+    }
+
+    vector_real_free(feedforward);
+    filter_free_digital_filter_real(reference);
+    half_band_decimator_real_free(decimator);
+}
@@ -1,4 +1,46 @@
+#include <stdbool.h>
+#include <stddef.h>
 #include "assertions.h"
 #include "munit.h"
 
 #define assert_complex_equal(a, b, precision) munit_assert_double_equal(creal(a), creal(b), precision); munit_assert_double_equal(cimag(a), cimag(b), precision);
+
+/**
+ * @brief 
+ * Block of a test signal, for checking that block processing matches sample-by-sample processing
+ */
+typedef struct {
+    size_t start; /** Index of the first value of the block */
+    size_t length; /** Number of values in the block */
+    size_t index; /** Number of blocks before this one */
+} TestBlock;
+
+/**
+ * @brief 
+ * Advances to the next block of a test signal.
+ * Lengths cycle through single values, an empty block, lengths either side of a power of two,
+ * and lengths longer than most filters and windows. The last block ends with the signal.
+ * @param block Block to advance, zero-initialized before the first block
+ * @param signal_length Number of values in the signal
+ * @return Whether there is another block
+ */
+static inline bool test_next_block(TestBlock *block, size_t signal_length) {
+    static const size_t lengths[] = {1, 37, 700, 0, 15, 16, 262, 2000, 4096, 7000};
+    block->start += block->length;
+    if (block->start >= signal_length)
+        return false;
+
+    size_t length = lengths[block->index % (sizeof(lengths) / sizeof(lengths[0]))];
+    block->length = length < signal_length - block->start ? length : signal_length - block->start;
+    block->index++;
+    return true;
+}
+
+/**
+ * @brief 
+ * Loops over a test signal split into blocks of varied lengths
+ * @param block Name of the `TestBlock` loop variable
+ * @param signal_length Number of values in the signal
+ */
+#define for_each_test_block(block, signal_length) \
+    for (TestBlock block = {0, 0, 0}; test_next_block(&block, signal_length);)